@@ -0,0 +1,304 @@
+// ---------------------------------
+// projects/integer/BenchInteger.c++
+// Copyright (C) 2013
+// Glenn P. Downing
+// ---------------------------------
+
+/*
+To run the benchmarks:
+    % g++ -pedantic -std=c++0x -Wall -O2 -DNDEBUG -pthread BenchInteger.c++ -o BenchInteger
+    % BenchInteger > BenchInteger.json
+    % BenchInteger 10000000 > BenchInteger.json
+
+The optional argument is the largest operand in digits, 1000000 by default.
+Sizes go up by powers of ten from 1.  A kernel stops climbing on a container
+once one of its operations takes more than a tenth of a second, since the
+next size up could then take several seconds for each operation.
+
+The digit kernels plus, minus, multiplies, divides and compare run on
+decimal digits.  The Integer kernels parse, print and pow also run on each
+wider radix over a vector.
+
+Each record in the JSON output has
+    kernel             plus, minus, multiplies, divides, compare, parse,
+                       print or pow
+    container          the container behind the digits, vector, deque, list
+                       or small_vector
+    radix              the digits in each element, decimal, decimal9,
+                       binary32 or binary64
+    digits             the size of each operand, or of the result of pow
+    iterations         how many timed operations the figures average over
+    ns_per_op          wall time per operation
+    digits_per_s       digits per second through the operation
+    allocations_per_op calls to operator new per operation, once the
+                       workspace has warmed up
+*/
+
+// --------
+// includes
+// --------
+
+#include <algorithm> // max
+#include <chrono>    // steady_clock
+#include <cmath>     // ceil, log10
+#include <cstdlib>   // atol, malloc, free, rand
+#include <deque>     // deque
+#include <iostream>  // cout, endl
+#include <list>      // list
+#include <new>       // bad_alloc
+#include <sstream>   // ostringstream
+#include <string>    // string
+#include <vector>    // vector
+
+#include "Integer.h"
+
+// -----------
+// allocations
+// -----------
+
+namespace {
+
+unsigned long long allocations = 0;
+
+}
+
+void* operator new (std::size_t size) {
+    ++allocations;
+    if (void* p = std::malloc(size ? size : 1))
+        return p;
+    throw std::bad_alloc();
+}
+
+void* operator new[] (std::size_t size) {
+    return operator new(size);
+}
+
+// gcc pairs the malloc above with each inlined delete and takes the free
+// below for a mismatch
+#if defined(__GNUC__) && (__GNUC__ >= 11)
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+void operator delete (void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete[] (void* p) noexcept {
+    std::free(p);
+}
+
+namespace {
+
+// -------
+// measure
+// -------
+
+const double budget = 0.1; // seconds of timed operations per record
+
+struct result {
+    unsigned long long iterations;
+    double             nanoseconds;
+    double             allocations;};
+
+/**
+ * @param f an operation to time
+ * @return the time and allocations per call of f
+ * One untimed call warms the workspace up, then the batch doubles until it
+ * fills the budget.
+ */
+template <typename F>
+result measure (F f) {
+    typedef std::chrono::steady_clock clock;
+    typedef std::chrono::duration<double> seconds;
+
+    clock::time_point start = clock::now();
+    f();
+    double elapsed = seconds(clock::now() - start).count();
+
+    unsigned long long iterations = 1;
+    if (elapsed < budget)
+        iterations = static_cast<unsigned long long>(budget / std::max(elapsed, 1e-9) / 4) + 1;
+    for (;;) {
+        const unsigned long long before = allocations;
+        start = clock::now();
+        for (unsigned long long i = 0; i != iterations; ++i)
+            f();
+        elapsed = seconds(clock::now() - start).count();
+        if ((elapsed >= budget) || (iterations >= (1ULL << 30))) {
+            const result r = {iterations, elapsed * 1e9 / iterations, double(allocations - before) / iterations};
+            return r;}
+        iterations *= 2;}}
+
+// -------
+// digits
+// -------
+
+/**
+ * @param n the number of digits
+ * @return n random decimal digits without a leading zero
+ */
+std::string random_digits (std::size_t n) {
+    std::string s(n, '0');
+    s[0] = static_cast<char>('1' + std::rand() % 9);
+    for (std::size_t i = 1; i < n; ++i)
+        s[i] = static_cast<char>('0' + std::rand() % 10);
+    return s;}
+
+/**
+ * @param s a string of decimal digits
+ * @return the digits of s in a C
+ */
+template <typename C>
+C to_digits (const std::string& s) {
+    C c;
+    for (std::string::const_iterator i = s.begin(); i != s.end(); ++i)
+        c.push_back(*i - '0');
+    return c;}
+
+// -------
+// records
+// -------
+
+bool first_record = true;
+
+/**
+ * Prints one JSON record for a kernel on a container and radix
+ * @return the nanoseconds per operation
+ */
+double report (const char* kernel, const char* container, const char* radix, std::size_t digits, const result& r) {
+    using namespace std;
+    cout << (first_record ? "\n" : ",\n");
+    first_record = false;
+    cout << "    {\"kernel\": \"" << kernel << "\", \"container\": \"" << container << "\", \"radix\": \"" << radix
+         << "\", \"digits\": " << digits
+         << ", \"iterations\": " << r.iterations << ", \"ns_per_op\": " << r.nanoseconds
+         << ", \"digits_per_s\": " << digits * 1e9 / r.nanoseconds << ", \"allocations_per_op\": " << r.allocations << "}";
+    return r.nanoseconds;}
+
+/**
+ * @return whether the next size up is cheap enough to run after an
+ * operation of nanoseconds
+ */
+bool affordable (double nanoseconds) {
+    return nanoseconds < budget * 1e9;}
+
+volatile int sink;
+
+// -----
+// bench
+// -----
+
+/**
+ * Runs the digit kernels on decimal digits of type C, for sizes 1, 10, ...
+ * up to maxDigits
+ */
+template <typename C>
+void bench_digits (const char* container, std::size_t maxDigits) {
+    const char* const kernels[] = {"plus", "minus", "multiplies", "divides", "compare"};
+    const std::size_t count = sizeof(kernels) / sizeof(kernels[0]);
+    std::vector<bool> running(count, true);
+
+    for (std::size_t n = 1; n <= maxDigits; n *= 10) {
+        const C a = to_digits<C>(random_digits(n));
+        const C b = to_digits<C>(random_digits(n));
+
+        // minuend above subtrahend, dividend twice as long as the divisor
+        C big = a;
+        big.front() = 9;
+        C small = b;
+        small.front() = 1;
+        const C dividend = to_digits<C>(random_digits(2 * n));
+
+        if (running[0]) {
+            C x(n + 1);
+            running[0] = affordable(report(kernels[0], container, "decimal", n, measure([&] () {
+                plus_digits(a.begin(), a.end(), b.begin(), b.end(), x.begin());})));}
+
+        if (running[1]) {
+            C x(n);
+            running[1] = affordable(report(kernels[1], container, "decimal", n, measure([&] () {
+                minus_digits(big.begin(), big.end(), small.begin(), small.end(), x.begin());})));}
+
+        if (running[2]) {
+            C x(2 * n);
+            running[2] = affordable(report(kernels[2], container, "decimal", n, measure([&] () {
+                multiplies_digits(a.begin(), a.end(), b.begin(), b.end(), x.begin());})));}
+
+        if (running[3]) {
+            C x(n + 1);
+            running[3] = affordable(report(kernels[3], container, "decimal", n, measure([&] () {
+                divides_digits(dividend.begin(), dividend.end(), a.begin(), a.end(), x.begin());})));}
+
+        if (running[4]) {
+            const C copy = a;
+            running[4] = affordable(report(kernels[4], container, "decimal", n, measure([&] () {
+                sink = compare(a.begin(), a.end(), copy.begin(), copy.end());})));}
+
+        if (n > maxDigits / 10)
+            break;}}
+
+/**
+ * Runs the Integer kernels on Integer<T, C, R>, for sizes 1, 10, ... up to
+ * maxDigits decimal digits
+ */
+template <typename T, typename C, typename R>
+void bench_integer (const char* container, const char* radix, std::size_t maxDigits) {
+    typedef Integer<T, C, R> integer;
+    const char* const kernels[] = {"parse", "print", "pow"};
+    const std::size_t count = sizeof(kernels) / sizeof(kernels[0]);
+    std::vector<bool> running(count, true);
+
+    for (std::size_t n = 1; n <= maxDigits; n *= 10) {
+        const std::string s = random_digits(n);
+
+        if (running[0]) {
+            running[0] = affordable(report(kernels[0], container, radix, n, measure([&] () {
+                const integer x(s);
+                sink = x == 0;})));}
+
+        if (running[1]) {
+            const integer x(s);
+            running[1] = affordable(report(kernels[1], container, radix, n, measure([&] () {
+                std::ostringstream out;
+                out << x;
+                sink = static_cast<int>(out.tellp());})));}
+
+        // 3^e has about n digits
+        if (running[2]) {
+            const int e = std::max(1, static_cast<int>(std::ceil((n - 1) / std::log10(3.0))));
+            running[2] = affordable(report(kernels[2], container, radix, n, measure([&] () {
+                const integer x = integer(3).pow(e);
+                sink = x == 0;})));}
+
+        if (n > maxDigits / 10)
+            break;}}
+
+}
+
+// ----
+// main
+// ----
+
+int main (int argc, char* argv[]) {
+    using namespace std;
+    const size_t maxDigits = (argc > 1) ? static_cast<size_t>(atol(argv[1])) : 1000000;
+
+    cout << "{\"benchmark\": \"BenchInteger.c++\", \"max_digits\": " << maxDigits << ", \"results\": [";
+    bench_digits< std::vector<int>       >("vector",       maxDigits);
+    bench_digits< std::deque<int>        >("deque",        maxDigits);
+    bench_digits< std::list<int>         >("list",         maxDigits);
+    bench_digits< small_vector<int, 10>  >("small_vector", maxDigits);
+
+    bench_integer<int, std::vector<int>,      decimal_radix>("vector",       "decimal", maxDigits);
+    bench_integer<int, std::deque<int>,       decimal_radix>("deque",        "decimal", maxDigits);
+    bench_integer<int, std::list<int>,        decimal_radix>("list",         "decimal", maxDigits);
+    bench_integer<int, small_vector<int, 10>, decimal_radix>("small_vector", "decimal", maxDigits);
+
+    bench_integer<unsigned, std::vector<unsigned>, decimal9_radix>("vector", "decimal9", maxDigits);
+    bench_integer<unsigned, std::vector<unsigned>, binary32_radix>("vector", "binary32", maxDigits);
+#ifdef __SIZEOF_INT128__
+    bench_integer<unsigned long long, std::vector<unsigned long long>, binary64_radix>("vector", "binary64", maxDigits);
+#endif
+    cout << "\n]}" << endl;
+
+    return 0;}
@@ -11,22 +11,591 @@
 // includes
 // --------
 
+#include <atomic>    // atomic
 #include <cassert>   // assert
+#include <cstddef>   // size_t
+#include <condition_variable> // condition_variable
+#include <future>    // future, packaged_task
+#include <mutex>     // mutex, unique_lock
+#include <thread>    // thread
 #include <iostream>  // ostream
 #include <stdexcept> // invalid_argument
+#include <system_error> // system_error
 #include <string>    // string
+#include <type_traits> // is_integral
 #include <iterator>  // iterator tags
 #include <algorithm> // reverse
+#include <functional> // bit_and, bit_or, bit_xor
+#include <utility>   // move, pair
 #include <math.h>    // pow
 // Comparing the performance of these structures
 #include <deque>     // deque
 #include <list>      // list
 #include <vector>    // vector
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define INTEGER_SIMD
+#include <immintrin.h> // SSE2, AVX2
+#endif
 // Typedefs
 typedef std::bidirectional_iterator_tag biTag;
 typedef std::input_iterator_tag inTag;
 typedef std::random_access_iterator_tag ranTag;
 
+// -----
+// Radix
+// -----
+
+/*
+ * A radix policy tells the kernels what one element of a digit sequence
+ * holds: the base, and an unsigned and a signed type wide enough for the
+ * product of two elements plus a carry.  Every kernel takes the policy as an
+ * optional last argument; the overloads without one work in base 10.
+ */
+
+/**
+ * One decimal digit per element, the original layout
+ */
+struct decimal_radix {
+	typedef unsigned long long wide_type;
+	typedef long long signed_wide_type;
+
+	static wide_type base() {
+		return 10;
+	}
+};
+
+/**
+ * One 32 bit binary limb per element
+ * The element type needs to hold values up to 2^32 - 1, e.g. unsigned int
+ */
+struct binary32_radix {
+	typedef unsigned long long wide_type;
+	typedef long long signed_wide_type;
+
+	static wide_type base() {
+		return static_cast<wide_type>(1) << 32;
+	}
+};
+
+/**
+ * Nine decimal digits per element, base 10^9
+ * The element type needs to hold values up to 10^9 - 1, e.g. unsigned int
+ * Decimal digits are packed into these to be multiplied nine at a time
+ */
+struct decimal9_radix {
+	typedef unsigned long long wide_type;
+	typedef long long signed_wide_type;
+
+	static wide_type base() {
+		return 1000000000;
+	}
+};
+
+#ifdef __SIZEOF_INT128__
+/**
+ * One 64 bit binary limb per element
+ * The element type needs to hold values up to 2^64 - 1, e.g. unsigned long long
+ * Only available where the compiler has 128 bit integers for the wide products
+ */
+struct binary64_radix {
+	__extension__ typedef unsigned __int128 wide_type;
+	__extension__ typedef __int128 signed_wide_type;
+
+	static wide_type base() {
+		return static_cast<wide_type>(1) << 64;
+	}
+};
+#endif
+
+// ---------
+// Workspace
+// ---------
+
+/**
+ * Scratch memory for the kernels, handed out last in first out
+ * A kernel opens a frame, draws its temporaries from the workspace, and
+ * everything drawn through the frame is given back when the frame closes.
+ * The blocks themselves are kept, so once a workspace has grown to the
+ * size of an operation, repeating it doesn't touch the allocator again.
+ * Every kernel that needs scratch has an overload taking a workspace; the
+ * others use default_workspace(), one per thread.
+ */
+class workspace {
+	public:
+		/**
+		 * Returns everything drawn from the workspace since it was opened
+		 */
+		class frame {
+			public:
+				explicit frame(workspace& w) :
+						owner(w),
+						block(w.block),
+						used(w.used) {
+				}
+
+				~frame() {
+					owner.block = block;
+					owner.used = used;
+				}
+
+			private:
+				frame(const frame&);
+				frame& operator=(const frame&);
+
+				workspace& owner;
+				std::size_t block;
+				std::size_t used;
+		};
+
+	private:
+		// Enough for any built-in type
+		static const std::size_t ALIGNMENT = 16;
+		static const std::size_t MINIMUM_BLOCK = 4096;
+
+		// Blocks past the current one are free
+		std::vector< std::pair<char*, std::size_t> > blocks;
+		std::size_t block;
+		std::size_t used;
+
+		workspace(const workspace&);
+		workspace& operator=(const workspace&);
+
+		char* allocate_bytes(std::size_t size) {
+			size = (size + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+			if (block < blocks.size() && used + size <= blocks[block].second) {
+				char* p = blocks[block].first + used;
+				used += size;
+				return p;
+			}
+
+			// Move on to the next block, replacing it if it is too small
+			std::size_t next = block;
+			if (block < blocks.size() && used > 0)
+				++next;
+			if (next < blocks.size() && blocks[next].second < size) {
+				delete[] blocks[next].first;
+				blocks[next].first = 0;
+				blocks[next].second = 0;
+			}
+			if (next == blocks.size())
+				blocks.push_back(std::make_pair(static_cast<char*>(0), static_cast<std::size_t>(0)));
+			if (blocks[next].first == 0) {
+				std::size_t room = MINIMUM_BLOCK;
+				room = std::max(room, size);
+				if (next > 0)
+					room = std::max(room, 2 * blocks[next - 1].second);
+				blocks[next].first = new char[room];
+				blocks[next].second = room;
+			}
+			block = next;
+			used = size;
+			return blocks[next].first;
+		}
+
+	public:
+		workspace() :
+				block(0),
+				used(0) {
+		}
+
+		~workspace() {
+			for (std::size_t i = 0; i < blocks.size(); ++i)
+				delete[] blocks[i].first;
+		}
+
+		/**
+		 * @param n the number of elements
+		 * @return n zeroed elements of a built-in type, valid until the
+		 * innermost open frame closes
+		 */
+		template<typename T>
+		T* allocate(std::size_t n) {
+			T* p = reinterpret_cast<T*>(allocate_bytes(std::max<std::size_t>(n, 1) * sizeof(T)));
+			std::fill(p, p + n, T());
+			return p;
+		}
+
+		/**
+		 * @return the bytes held, in use or not
+		 */
+		std::size_t capacity() const {
+			std::size_t total = 0;
+			for (std::size_t i = 0; i < blocks.size(); ++i)
+				total += blocks[i].second;
+			return total;
+		}
+};
+
+/**
+ * @return this thread's workspace
+ */
+inline workspace& default_workspace() {
+	static thread_local workspace w;
+	return w;
+}
+
+// ----
+// SIMD
+// ----
+
+/*
+ * On x86 the carry chains of addition and subtraction are broken with
+ * carry lookahead across the lanes of SSE2 or AVX2 registers, and zero
+ * and equality scans compare whole registers at a time.  The instruction
+ * set is picked at run time, so one binary runs everywhere.  The lanes hold
+ * 32 bit digits of a base no larger than 2^30, which covers decimal_radix
+ * and decimal9_radix; everything else keeps the scalar loops.
+ */
+
+enum simd_level {
+	SIMD_NONE,
+	SIMD_SSE2,
+	SIMD_AVX2
+};
+
+/**
+ * @return the widest instruction set this processor has, from CPUID
+ */
+inline simd_level detect_simd() {
+#ifdef INTEGER_SIMD
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx2"))
+		return SIMD_AVX2;
+	if (__builtin_cpu_supports("sse2"))
+		return SIMD_SSE2;
+#endif
+	return SIMD_NONE;
+}
+
+/**
+ * The instruction set the kernels use, detected once
+ * Returned by reference so it can be lowered, e.g. to test the fallbacks;
+ * raising it past detect_simd() is undefined
+ */
+inline simd_level& simd_support() {
+	static simd_level level = detect_simd();
+	return level;
+}
+
+/**
+ * Carry lookahead across the lanes of one register, least significant first
+ * g marks the lanes that carry out by themselves and p the lanes that pass
+ * a carry in along, so adding g to g | p ripples every carry to the lane it
+ * lands in with one integer addition
+ * @return the lanes that take a carry in; carry becomes the carry out of the top lane
+ */
+inline unsigned lookahead(unsigned g, unsigned p, unsigned& carry, unsigned lanes) {
+	const unsigned s = g + (g | p) + carry;
+	carry = s >> lanes;
+	return (s ^ p) & ((1u << lanes) - 1);
+}
+
+#ifdef INTEGER_SIMD
+/*
+ * The kernels below take the least significant end of each operand: the
+ * beginnings when little endian, the ends when big endian, in which case
+ * the lanes are reversed after every load and before every store.  Each
+ * register is loaded before it is stored, so the output may be either
+ * input.  They return how many digits they did, a multiple of the lanes.
+ */
+
+template<bool BACKWARDS>
+__attribute__((target("avx2")))
+std::size_t plus_lanes_avx2(const int* a, const int* b, int* r, std::size_t n, int base, unsigned& carry) {
+	const __m256i reverse = _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0);
+	const __m256i bits = _mm256_setr_epi32(1, 2, 4, 8, 16, 32, 64, 128);
+	const __m256i top = _mm256_set1_epi32(base - 1);
+	const __m256i radix = _mm256_set1_epi32(base);
+
+	std::size_t i = 0;
+	for (; i + 8 <= n; i += 8) {
+		const std::ptrdiff_t offset = BACKWARDS ? -static_cast<std::ptrdiff_t>(i + 8) : static_cast<std::ptrdiff_t>(i);
+		__m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + offset));
+		__m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + offset));
+		if (BACKWARDS) {
+			x = _mm256_permutevar8x32_epi32(x, reverse);
+			y = _mm256_permutevar8x32_epi32(y, reverse);
+		}
+		const __m256i s = _mm256_add_epi32(x, y);
+		const unsigned g = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(s, top)));
+		const unsigned p = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(s, top)));
+		const unsigned c = lookahead(g, p, carry, 8);
+		const unsigned o = g | (p & c);
+		const __m256i carryIn = _mm256_cmpeq_epi32(_mm256_and_si256(_mm256_set1_epi32(c), bits), bits);
+		const __m256i carryOut = _mm256_cmpeq_epi32(_mm256_and_si256(_mm256_set1_epi32(o), bits), bits);
+		// s + 1 where a carry comes in, - B where one goes out
+		__m256i z = _mm256_sub_epi32(s, carryIn);
+		z = _mm256_sub_epi32(z, _mm256_and_si256(carryOut, radix));
+		if (BACKWARDS)
+			z = _mm256_permutevar8x32_epi32(z, reverse);
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(r + offset), z);
+	}
+	return i;
+}
+
+template<bool BACKWARDS>
+__attribute__((target("avx2")))
+std::size_t minus_lanes_avx2(const int* a, const int* b, int* r, std::size_t n, int base, unsigned& borrow) {
+	const __m256i reverse = _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0);
+	const __m256i bits = _mm256_setr_epi32(1, 2, 4, 8, 16, 32, 64, 128);
+	const __m256i zero = _mm256_setzero_si256();
+	const __m256i radix = _mm256_set1_epi32(base);
+
+	std::size_t i = 0;
+	for (; i + 8 <= n; i += 8) {
+		const std::ptrdiff_t offset = BACKWARDS ? -static_cast<std::ptrdiff_t>(i + 8) : static_cast<std::ptrdiff_t>(i);
+		__m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + offset));
+		__m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + offset));
+		if (BACKWARDS) {
+			x = _mm256_permutevar8x32_epi32(x, reverse);
+			y = _mm256_permutevar8x32_epi32(y, reverse);
+		}
+		const __m256i d = _mm256_sub_epi32(x, y);
+		const unsigned g = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(zero, d)));
+		const unsigned p = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(d, zero)));
+		const unsigned c = lookahead(g, p, borrow, 8);
+		const unsigned o = g | (p & c);
+		const __m256i borrowIn = _mm256_cmpeq_epi32(_mm256_and_si256(_mm256_set1_epi32(c), bits), bits);
+		const __m256i borrowOut = _mm256_cmpeq_epi32(_mm256_and_si256(_mm256_set1_epi32(o), bits), bits);
+		// d - 1 where a borrow comes in, + B where one goes out
+		__m256i z = _mm256_add_epi32(d, borrowIn);
+		z = _mm256_add_epi32(z, _mm256_and_si256(borrowOut, radix));
+		if (BACKWARDS)
+			z = _mm256_permutevar8x32_epi32(z, reverse);
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(r + offset), z);
+	}
+	return i;
+}
+
+template<bool BACKWARDS>
+__attribute__((target("sse2")))
+std::size_t plus_lanes_sse2(const int* a, const int* b, int* r, std::size_t n, int base, unsigned& carry) {
+	const __m128i bits = _mm_setr_epi32(1, 2, 4, 8);
+	const __m128i top = _mm_set1_epi32(base - 1);
+	const __m128i radix = _mm_set1_epi32(base);
+
+	std::size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		const std::ptrdiff_t offset = BACKWARDS ? -static_cast<std::ptrdiff_t>(i + 4) : static_cast<std::ptrdiff_t>(i);
+		__m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + offset));
+		__m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + offset));
+		if (BACKWARDS) {
+			x = _mm_shuffle_epi32(x, 0x1B);
+			y = _mm_shuffle_epi32(y, 0x1B);
+		}
+		const __m128i s = _mm_add_epi32(x, y);
+		const unsigned g = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(s, top)));
+		const unsigned p = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(s, top)));
+		const unsigned c = lookahead(g, p, carry, 4);
+		const unsigned o = g | (p & c);
+		const __m128i carryIn = _mm_cmpeq_epi32(_mm_and_si128(_mm_set1_epi32(c), bits), bits);
+		const __m128i carryOut = _mm_cmpeq_epi32(_mm_and_si128(_mm_set1_epi32(o), bits), bits);
+		__m128i z = _mm_sub_epi32(s, carryIn);
+		z = _mm_sub_epi32(z, _mm_and_si128(carryOut, radix));
+		if (BACKWARDS)
+			z = _mm_shuffle_epi32(z, 0x1B);
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(r + offset), z);
+	}
+	return i;
+}
+
+template<bool BACKWARDS>
+__attribute__((target("sse2")))
+std::size_t minus_lanes_sse2(const int* a, const int* b, int* r, std::size_t n, int base, unsigned& borrow) {
+	const __m128i bits = _mm_setr_epi32(1, 2, 4, 8);
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i radix = _mm_set1_epi32(base);
+
+	std::size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		const std::ptrdiff_t offset = BACKWARDS ? -static_cast<std::ptrdiff_t>(i + 4) : static_cast<std::ptrdiff_t>(i);
+		__m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + offset));
+		__m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + offset));
+		if (BACKWARDS) {
+			x = _mm_shuffle_epi32(x, 0x1B);
+			y = _mm_shuffle_epi32(y, 0x1B);
+		}
+		const __m128i d = _mm_sub_epi32(x, y);
+		const unsigned g = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(zero, d)));
+		const unsigned p = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(d, zero)));
+		const unsigned c = lookahead(g, p, borrow, 4);
+		const unsigned o = g | (p & c);
+		const __m128i borrowIn = _mm_cmpeq_epi32(_mm_and_si128(_mm_set1_epi32(c), bits), bits);
+		const __m128i borrowOut = _mm_cmpeq_epi32(_mm_and_si128(_mm_set1_epi32(o), bits), bits);
+		__m128i z = _mm_add_epi32(d, borrowIn);
+		z = _mm_add_epi32(z, _mm_and_si128(borrowOut, radix));
+		if (BACKWARDS)
+			z = _mm_shuffle_epi32(z, 0x1B);
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(r + offset), z);
+	}
+	return i;
+}
+
+__attribute__((target("avx2")))
+inline const char* find_nonzero_avx2(const char* b, const char* e) {
+	const __m256i zero = _mm256_setzero_si256();
+	for (; e - b >= 32; b += 32) {
+		const unsigned zeroes = _mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(b)), zero));
+		if (zeroes != 0xFFFFFFFFu)
+			return b + __builtin_ctz(~zeroes);
+	}
+	return b;
+}
+
+__attribute__((target("sse2")))
+inline const char* find_nonzero_sse2(const char* b, const char* e) {
+	const __m128i zero = _mm_setzero_si128();
+	for (; e - b >= 16; b += 16) {
+		const unsigned zeroes = _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(b)), zero));
+		if (zeroes != 0xFFFFu)
+			return b + __builtin_ctz(~zeroes & 0xFFFFu);
+	}
+	return b;
+}
+
+__attribute__((target("avx2")))
+inline std::size_t mismatch_avx2(const char* a, const char* b, std::size_t n) {
+	std::size_t i = 0;
+	for (; i + 32 <= n; i += 32) {
+		const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+		const __m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+		const unsigned equal = _mm256_movemask_epi8(_mm256_cmpeq_epi8(x, y));
+		if (equal != 0xFFFFFFFFu)
+			return i + __builtin_ctz(~equal);
+	}
+	return i;
+}
+
+__attribute__((target("sse2")))
+inline std::size_t mismatch_sse2(const char* a, const char* b, std::size_t n) {
+	std::size_t i = 0;
+	for (; i + 16 <= n; i += 16) {
+		const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+		const __m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+		const unsigned equal = _mm_movemask_epi8(_mm_cmpeq_epi8(x, y));
+		if (equal != 0xFFFFu)
+			return i + __builtin_ctz(~equal & 0xFFFFu);
+	}
+	return i;
+}
+#endif
+
+/**
+ * [a, a + n) + [b, b + n) => [r, r + n) in as many whole registers as fit,
+ * least significant end first as above
+ * @return the number of digits done
+ */
+template<bool BACKWARDS>
+std::size_t plus_lanes(const int* a, const int* b, int* r, std::size_t n, int base, unsigned& carry) {
+#ifdef INTEGER_SIMD
+	switch (simd_support()) {
+		case SIMD_AVX2:
+			return plus_lanes_avx2<BACKWARDS>(a, b, r, n, base, carry);
+		case SIMD_SSE2:
+			return plus_lanes_sse2<BACKWARDS>(a, b, r, n, base, carry);
+		default:
+			break;
+	}
+#endif
+	return 0;
+}
+
+/**
+ * [a, a + n) - [b, b + n) => [r, r + n) in as many whole registers as fit,
+ * least significant end first as above
+ * @return the number of digits done
+ */
+template<bool BACKWARDS>
+std::size_t minus_lanes(const int* a, const int* b, int* r, std::size_t n, int base, unsigned& borrow) {
+#ifdef INTEGER_SIMD
+	switch (simd_support()) {
+		case SIMD_AVX2:
+			return minus_lanes_avx2<BACKWARDS>(a, b, r, n, base, borrow);
+		case SIMD_SSE2:
+			return minus_lanes_sse2<BACKWARDS>(a, b, r, n, base, borrow);
+		default:
+			break;
+	}
+#endif
+	return 0;
+}
+
+/**
+ * @return the first nonzero byte of [b, e), or e
+ */
+inline const char* find_nonzero(const char* b, const char* e) {
+#ifdef INTEGER_SIMD
+	if (simd_support() == SIMD_AVX2)
+		b = find_nonzero_avx2(b, e);
+	else if (simd_support() == SIMD_SSE2)
+		b = find_nonzero_sse2(b, e);
+#endif
+	while (b != e && *b == 0)
+		++b;
+	return b;
+}
+
+/**
+ * @return the offset of the first byte where [a, a + n) and [b, b + n) differ, or n
+ */
+inline std::size_t mismatch_bytes(const char* a, const char* b, std::size_t n) {
+	std::size_t i = 0;
+#ifdef INTEGER_SIMD
+	if (simd_support() == SIMD_AVX2)
+		i = mismatch_avx2(a, b, n);
+	else if (simd_support() == SIMD_SSE2)
+		i = mismatch_sse2(a, b, n);
+#endif
+	while (i != n && a[i] == b[i])
+		++i;
+	return i;
+}
+
+/**
+ * Whether digits of type T in radix R fit the lanes
+ */
+template<typename T, typename R>
+bool lanes_fit(R) {
+	return std::is_integral<T>::value && sizeof(T) == sizeof(int) && R::base() <= (static_cast<typename R::wide_type>(1) << 30);
+}
+
+/**
+ * The lane kernels for digits that are held in contiguous memory; any other
+ * iterators do nothing here and are left to the scalar loops
+ * @return the number of digits done, from the least significant end
+ */
+template<typename I1, typename I2, typename O, typename R>
+std::size_t plus_digits_lanes(I1, I2, O, std::size_t, bool&, R) {
+	return 0;
+}
+
+template<typename T1, typename T2, typename T, typename R>
+typename std::enable_if<std::is_same<typename std::remove_const<T1>::type, T>::value && std::is_same<typename std::remove_const<T2>::type, T>::value, std::size_t>::type
+plus_digits_lanes(T1* e1, T2* e2, T* x, std::size_t n, bool& carry, R r) {
+	if (!lanes_fit<T>(r))
+		return 0;
+	unsigned c = carry;
+	const std::size_t done = plus_lanes<true>(reinterpret_cast<const int*>(e1), reinterpret_cast<const int*>(e2), reinterpret_cast<int*>(x), n, static_cast<int>(R::base()), c);
+	carry = c != 0;
+	return done;
+}
+
+template<typename I1, typename I2, typename O, typename R>
+std::size_t minus_digits_lanes(I1, I2, O, std::size_t, bool&, R) {
+	return 0;
+}
+
+template<typename T1, typename T2, typename T, typename R>
+typename std::enable_if<std::is_same<typename std::remove_const<T1>::type, T>::value && std::is_same<typename std::remove_const<T2>::type, T>::value, std::size_t>::type
+minus_digits_lanes(T1* e1, T2* e2, T* x, std::size_t n, bool& borrow, R r) {
+	if (!lanes_fit<T>(r))
+		return 0;
+	unsigned c = borrow;
+	const std::size_t done = minus_lanes<true>(reinterpret_cast<const int*>(e1), reinterpret_cast<const int*>(e2), reinterpret_cast<int*>(x), n, static_cast<int>(R::base()), c);
+	borrow = c != 0;
+	return done;
+}
+
 // Helper functions
 /** 
  * @param b  an iterator to the beginning of an input  sequence (inclusive)
@@ -40,6 +609,13 @@ II strip_zeroes(II b, II e) {
 	return b;
 }
 
+// Contiguous digits are scanned a register at a time
+template<typename T>
+typename std::enable_if<std::is_integral<T>::value, T*>::type strip_zeroes(T* b, T* e) {
+	const char* first = find_nonzero(reinterpret_cast<const char*>(b), reinterpret_cast<const char*>(e));
+	return b + (first - reinterpret_cast<const char*>(b)) / sizeof(T);
+}
+
 /**
  * @param b  an iterator to the beginning of an input  sequence (inclusive)
  * @param e  an iterator to the end       of an input  sequence (exclusive)
@@ -96,6 +672,29 @@ int compare(II1 b1, II1 e1, II2 b2, II2 e2) {
 	return 0;
 }
 
+/**
+ * @return whether [b, e), without leading zeroes, is the value 1
+ */
+template<typename I>
+bool is_one(I b, I e) {
+	return b != e && *b == 1 && ++b == e;
+}
+
+// Contiguous digits are compared a register at a time
+template<typename T1, typename T2>
+typename std::enable_if<std::is_integral<T1>::value && std::is_same<typename std::remove_const<T1>::type, typename std::remove_const<T2>::type>::value, int>::type
+compare(T1* b1, T1* e1, T2* b2, T2* e2) {
+	b1 = strip_zeroes(b1, e1);
+	b2 = strip_zeroes(b2, e2);
+	if (e1 - b1 != e2 - b2)
+		return e1 - b1 > e2 - b2 ? 1 : -1;
+
+	const std::size_t i = mismatch_bytes(reinterpret_cast<const char*>(b1), reinterpret_cast<const char*>(b2), (e1 - b1) * sizeof(T1)) / sizeof(T1);
+	if (b1 + i == e1)
+		return 0;
+	return b1[i] > b2[i] ? 1 : -1;
+}
+
 // Main functions
 /**
  * @param b an iterator to the beginning of an input  sequence (inclusive)
@@ -166,46 +765,131 @@ OI shift_right_digits(I b, I e, int n, OI x) {
 // plus_digits
 // bidirection iterators
 // O(n)
-template<typename BI1, typename BI2, typename OI>
-OI plus_digits(BI1 b1, BI1 e1, BI2 b2, BI2 e2, OI x, biTag, biTag) {
-	typedef std::deque<typename std::iterator_traits<OI>::value_type> result_list;
-	typedef typename result_list::iterator result_list_iterator;
-	typedef typename std::iterator_traits<BI1>::difference_type dType1;
-	typedef typename std::iterator_traits<BI2>::difference_type dType2;
+template<typename BI1, typename BI2, typename OI, typename R>
+OI plus_digits(BI1 b1, BI1 e1, BI2 b2, BI2 e2, OI x, biTag, biTag, R, workspace& w) {
+	typedef typename std::iterator_traits<OI>::value_type result_type;
+	typedef typename R::wide_type wide_type;
 
-	result_list result;
+	// Filled from the back, least significant digit first
+	workspace::frame frame(w);
+	const std::size_t length = std::max<std::size_t>(std::distance(b1, e1), std::distance(b2, e2)) + 1;
+	result_type* const result = w.allocate<result_type>(length);
+	result_type* digit = result + length;
 
-	int carry = 0;
+	wide_type carry = 0;
 	while (b1 != e1 && b2 != e2) {
 		--e1;
 		--e2;
-		carry += *e1 + *e2;
-		result.push_front(carry % 10);
-		carry /= 10;
+		carry += static_cast<wide_type>(*e1) + *e2;
+		*--digit = carry % R::base();
+		carry /= R::base();
 	}
 
 	while (b1 != e1) {
 		--e1;
 		carry += *e1;
-		result.push_front(carry % 10);
-		carry /= 10;
+		*--digit = carry % R::base();
+		carry /= R::base();
 	}
 
 	while (b2 != e2) {
 		--e2;
 		carry += *e2;
-		result.push_front(carry % 10);
-		carry /= 10;
+		*--digit = carry % R::base();
+		carry /= R::base();
 	}
-	result.push_front(carry);
-	return print_list(result.begin(), result.end(), x);
+	*--digit = carry;
+	return print_list(digit, result + length, x);
+}
+
+// random access iterators into an output that can be written backwards
+// O(n), one pass straight into the output
+template<typename RI1, typename RI2, typename BO, typename R>
+BO plus_digits(RI1 b1, RI1 e1, RI2 b2, RI2 e2, BO x, ranTag, ranTag, R r, workspace&, biTag) {
+	typedef typename R::wide_type wide_type;
+
+	const std::size_t len1 = e1 - b1;
+	const std::size_t len2 = e2 - b2;
+	const std::size_t length = std::max(len1, len2);
+
+	// The carry out of the top is settled by the first aligned pair, from
+	// the top down, that doesn't add up to B - 1, so the length of the sum
+	// is known before the first digit is written
+	bool carryOut = false;
+	for (std::size_t i = 0; i < length; ++i) {
+		wide_type sum = 0;
+		if (i + len1 >= length)
+			sum += b1[i + len1 - length];
+		if (i + len2 >= length)
+			sum += b2[i + len2 - length];
+		if (sum != R::base() - 1) {
+			carryOut = sum >= R::base();
+			break;
+		}
+	}
+
+	std::advance(x, length + carryOut);
+	const BO result = x;
+
+	// Contiguous digits overlap in whole registers first
+	bool laneCarry = false;
+	const std::size_t done = plus_digits_lanes(e1, e2, x, std::min(len1, len2), laneCarry, r);
+	e1 -= done;
+	e2 -= done;
+	x -= done;
+
+	wide_type carry = laneCarry;
+	while (b1 != e1 && b2 != e2) {
+		--e1;
+		--e2;
+		carry += static_cast<wide_type>(*e1) + *e2;
+		*--x = carry % R::base();
+		carry /= R::base();
+	}
+
+	while (b1 != e1) {
+		--e1;
+		carry += *e1;
+		*--x = carry % R::base();
+		carry /= R::base();
+	}
+
+	while (b2 != e2) {
+		--e2;
+		carry += *e2;
+		*--x = carry % R::base();
+		carry /= R::base();
+	}
+	assert(carry == static_cast<wide_type>(carryOut));
+	if (carryOut)
+		*--x = carry;
+	return result;
+}
+
+// random access iterators into an output that can only be written forwards
+template<typename RI1, typename RI2, typename OI, typename R>
+OI plus_digits(RI1 b1, RI1 e1, RI2 b2, RI2 e2, OI x, ranTag, ranTag, R r, workspace& w, std::input_iterator_tag) {
+	return plus_digits(b1, e1, b2, e2, x, biTag(), biTag(), r, w);
+}
+
+template<typename RI1, typename RI2, typename OI, typename R>
+OI plus_digits(RI1 b1, RI1 e1, RI2 b2, RI2 e2, OI x, ranTag, ranTag, R r, workspace& w, std::output_iterator_tag) {
+	return plus_digits(b1, e1, b2, e2, x, biTag(), biTag(), r, w);
+}
+
+// random access iterators
+template<typename RI1, typename RI2, typename OI, typename R>
+OI plus_digits(RI1 b1, RI1 e1, RI2 b2, RI2 e2, OI x, ranTag, ranTag, R r, workspace& w) {
+	typedef typename std::iterator_traits<OI>::iterator_category oCat;
+	return plus_digits(b1, e1, b2, e2, x, ranTag(), ranTag(), r, w, oCat());
 }
 
 // input iterators
 // O(n^2)
-template<typename II1, typename II2, typename OI>
-OI plus_digits(II1 b1, II1 e1, II2 b2, II2 e2, OI x, inTag, inTag) {
-	typedef std::deque<typename std::iterator_traits<OI>::value_type> result_list;
+template<typename II1, typename II2, typename OI, typename R>
+OI plus_digits(II1 b1, II1 e1, II2 b2, II2 e2, OI x, inTag, inTag, R, workspace&) {
+	typedef typename R::wide_type wide_type;
+	typedef std::deque<wide_type> result_list;
 	typedef typename result_list::iterator result_list_iterator;
 	typedef typename std::iterator_traits<II1>::difference_type dType1;
 	typedef typename std::iterator_traits<II2>::difference_type dType2;
@@ -228,12 +912,12 @@ OI plus_digits(II1 b1, II1 e1, II2 b2, II2 e2, OI x, inTag, inTag) {
 	}
 
 	while (b1 != e1) {
-		result.push_back(*b1++ + *b2++);
+		result.push_back(static_cast<wide_type>(*b1++) + *b2++);
 
 		// Carry the 1 backwards through the array
 		result_list_iterator currentDigit = result.end() - 1;
-		while (*currentDigit >= 10) {
-			*currentDigit -= 10;
+		while (*currentDigit >= R::base()) {
+			*currentDigit -= R::base();
 			if (currentDigit == result.begin()) {
 				result.push_front(1);
 				break;
@@ -254,13 +938,19 @@ OI plus_digits(II1 b1, II1 e1, II2 b2, II2 e2, OI x, inTag, inTag) {
  * @param b2 an iterator to the beginning of an input  sequence (inclusive)
  * @param e2 an iterator to the end       of an input  sequence (exclusive)
  * @param x  an iterator to the beginning of an output sequence (inclusive)
+ * @param r  the radix policy of all three sequences
+ * @param w  the workspace to draw scratch from
  * @return   an iterator to the end       of an output sequence (exclusive)
- * the sequences are of decimal digits
  * output the sum of the two input sequences into the output sequence
  * ([b1, e1) + [b2, e2)) => x
+ *
+ * x may be b1 or b2 when that operand has no leading zeroes and its storage
+ * has room for the sum, max(e1 - b1, e2 - b2) + 1 digits; the sum then
+ * replaces the operand in place.  x may not point anywhere else inside
+ * either input.
  */
-template<typename I1, typename I2, typename OI>
-OI plus_digits(I1 b1, I1 e1, I2 b2, I2 e2, OI x) {
+template<typename I1, typename I2, typename OI, typename R>
+OI plus_digits(I1 b1, I1 e1, I2 b2, I2 e2, OI x, R r, workspace& w) {
 	typedef typename std::iterator_traits<I1>::iterator_category iCat1;
 	typedef typename std::iterator_traits<I2>::iterator_category iCat2;
 
@@ -273,33 +963,53 @@ OI plus_digits(I1 b1, I1 e1, I2 b2, I2 e2, OI x) {
 	if (b2 == e2)
 		return print_list(b1, e1, x);
 
-	return plus_digits(b1, e1, b2, e2, x, iCat1(), iCat2());
+	return plus_digits(b1, e1, b2, e2, x, iCat1(), iCat2(), r, w);
+}
+
+/**
+ * scratch comes from this thread's workspace
+ * ([b1, e1) + [b2, e2)) => x
+ */
+template<typename I1, typename I2, typename OI, typename R>
+OI plus_digits(I1 b1, I1 e1, I2 b2, I2 e2, OI x, R r) {
+	return plus_digits(b1, e1, b2, e2, x, r, default_workspace());
+}
+
+/**
+ * the sequences are of decimal digits
+ * ([b1, e1) + [b2, e2)) => x
+ */
+template<typename I1, typename I2, typename OI>
+OI plus_digits(I1 b1, I1 e1, I2 b2, I2 e2, OI x) {
+	return plus_digits(b1, e1, b2, e2, x, decimal_radix());
 }
 
 // minus_digits
 // bidirectional iterator
 // O(n)
-template<typename BI1, typename BI2, typename OI>
-OI minus_digits(BI1 b1, BI1 e1, BI2 b2, BI2 e2, OI x, biTag, biTag) {
-	typedef std::deque<typename std::iterator_traits<OI>::value_type> result_list;
-	typedef typename result_list::iterator result_list_iterator;
-	typedef typename std::iterator_traits<BI1>::difference_type dType1;
-	typedef typename std::iterator_traits<BI2>::difference_type dType2;
+template<typename BI1, typename BI2, typename OI, typename R>
+OI minus_digits(BI1 b1, BI1 e1, BI2 b2, BI2 e2, OI x, biTag, biTag, R, workspace& w) {
+	typedef typename std::iterator_traits<OI>::value_type result_type;
+	typedef typename R::signed_wide_type signed_wide_type;
 
-	result_list result;
+	// Filled from the back, least significant digit first
+	workspace::frame frame(w);
+	const std::size_t length = std::distance(b1, e1);
+	result_type* const result = w.allocate<result_type>(length);
+	result_type* digit = result + length;
 
 	bool borrow = false;
-	int difference;
+	signed_wide_type difference;
 	while (b2 != e2) {
 		--e1;
 		--e2;
-		difference = *e1 - *e2;
+		difference = static_cast<signed_wide_type>(*e1) - static_cast<signed_wide_type>(*e2);
 		if (borrow)
 			--difference;
 		borrow = difference < 0;
 		if (borrow)
-			difference += 10;
-		result.push_front(difference);
+			difference += R::base();
+		*--digit = difference;
 	}
 
 	while (b1 != e1) {
@@ -309,18 +1019,81 @@ OI minus_digits(BI1 b1, BI1 e1, BI2 b2, BI2 e2, OI x, biTag, biTag) {
 			--difference;
 		borrow = difference < 0;
 		if (borrow)
-			difference += 10;
-		result.push_front(difference);
+			difference += R::base();
+		*--digit = difference;
 	}
 
-	return print_list(result.begin(), result.end(), x);
+	return print_list(digit, result + length, x);
+}
+
+// random access iterators into an output that can be written backwards
+// O(n), one pass straight into the output
+template<typename RI1, typename RI2, typename BO, typename R>
+BO minus_digits(RI1 b1, RI1 e1, RI2 b2, RI2 e2, BO x, ranTag, ranTag, R r, workspace&, biTag) {
+	typedef typename R::signed_wide_type signed_wide_type;
+
+	std::advance(x, e1 - b1);
+	const BO result = x;
+
+	// Contiguous digits overlap in whole registers first
+	bool borrow = false;
+	const std::size_t done = minus_digits_lanes(e1, e2, x, e2 - b2, borrow, r);
+	e1 -= done;
+	e2 -= done;
+	x -= done;
+
+	signed_wide_type difference;
+	while (b2 != e2) {
+		--e1;
+		--e2;
+		difference = static_cast<signed_wide_type>(*e1) - static_cast<signed_wide_type>(*e2) - borrow;
+		borrow = difference < 0;
+		if (borrow)
+			difference += R::base();
+		*--x = difference;
+	}
+
+	while (b1 != e1) {
+		--e1;
+		difference = static_cast<signed_wide_type>(*e1) - borrow;
+		borrow = difference < 0;
+		if (borrow)
+			difference += R::base();
+		*--x = difference;
+	}
+	assert(!borrow);
+
+	// Only top digits that cancelled leave zeroes to move past
+	const BO first = strip_zeroes(x, result);
+	if (first == x)
+		return result;
+	return std::copy(first, result, x);
+}
+
+// random access iterators into an output that can only be written forwards
+template<typename RI1, typename RI2, typename OI, typename R>
+OI minus_digits(RI1 b1, RI1 e1, RI2 b2, RI2 e2, OI x, ranTag, ranTag, R r, workspace& w, std::input_iterator_tag) {
+	return minus_digits(b1, e1, b2, e2, x, biTag(), biTag(), r, w);
+}
+
+template<typename RI1, typename RI2, typename OI, typename R>
+OI minus_digits(RI1 b1, RI1 e1, RI2 b2, RI2 e2, OI x, ranTag, ranTag, R r, workspace& w, std::output_iterator_tag) {
+	return minus_digits(b1, e1, b2, e2, x, biTag(), biTag(), r, w);
+}
+
+// random access iterators
+template<typename RI1, typename RI2, typename OI, typename R>
+OI minus_digits(RI1 b1, RI1 e1, RI2 b2, RI2 e2, OI x, ranTag, ranTag, R r, workspace& w) {
+	typedef typename std::iterator_traits<OI>::iterator_category oCat;
+	return minus_digits(b1, e1, b2, e2, x, ranTag(), ranTag(), r, w, oCat());
 }
 
 // input iterators
 // O(n^2)
-template<typename II1, typename II2, typename OI>
-OI minus_digits(II1 b1, II1 e1, II2 b2, II2 e2, OI x, inTag, inTag) {
-	typedef std::deque<typename std::iterator_traits<OI>::value_type> result_list;
+template<typename II1, typename II2, typename OI, typename R>
+OI minus_digits(II1 b1, II1 e1, II2 b2, II2 e2, OI x, inTag, inTag, R, workspace&) {
+	typedef typename R::signed_wide_type signed_wide_type;
+	typedef std::deque<signed_wide_type> result_list;
 	typedef typename result_list::iterator result_list_iterator;
 	typedef typename std::iterator_traits<II1>::difference_type dType1;
 	typedef typename std::iterator_traits<II2>::difference_type dType2;
@@ -339,12 +1112,12 @@ OI minus_digits(II1 b1, II1 e1, II2 b2, II2 e2, OI x, inTag, inTag) {
 	}
 
 	while (b1 != e1) {
-		result.push_back(*b1++ - *b2++);
+		result.push_back(static_cast<signed_wide_type>(*b1++) - static_cast<signed_wide_type>(*b2++));
 
 		// Carry the 1 backwards through the array
 		result_list_iterator currentDigit = result.end() - 1;
 		while (*currentDigit < 0) {
-			*currentDigit += 10;
+			*currentDigit += R::base();
 			--currentDigit;
 			*currentDigit -= 1;
 		}
@@ -359,13 +1132,18 @@ OI minus_digits(II1 b1, II1 e1, II2 b2, II2 e2, OI x, inTag, inTag) {
  * @param b2 an iterator to the beginning of an input  sequence (inclusive)
  * @param e2 an iterator to the end       of an input  sequence (exclusive)
  * @param x  an iterator to the beginning of an output sequence (inclusive)
+ * @param r  the radix policy of all three sequences
+ * @param w  the workspace to draw scratch from
  * @return   an iterator to the end       of an output sequence (exclusive)
- * the sequences are of decimal digits
  * output the difference of the two input sequences into the output sequence
  * ([b1, e1) - [b2, e2)) => x
+ *
+ * x may be b1 or b2 when that operand has no leading zeroes and its storage
+ * has room for e1 - b1 digits; the difference then replaces the operand in
+ * place.  x may not point anywhere else inside either input.
  */
-template<typename I1, typename I2, typename OI>
-OI minus_digits(I1 b1, I1 e1, I2 b2, I2 e2, OI x) {
+template<typename I1, typename I2, typename OI, typename R>
+OI minus_digits(I1 b1, I1 e1, I2 b2, I2 e2, OI x, R r, workspace& w) {
 	typedef typename std::iterator_traits<I1>::iterator_category iCat1;
 	typedef typename std::iterator_traits<I2>::iterator_category iCat2;
 
@@ -384,26 +1162,100 @@ OI minus_digits(I1 b1, I1 e1, I2 b2, I2 e2, OI x) {
 		return print_list(b1, e1, x);
 	}
 
-	return minus_digits(b1, e1, b2, e2, x, iCat1(), iCat2());
+	return minus_digits(b1, e1, b2, e2, x, iCat1(), iCat2(), r, w);
+}
+
+/**
+ * scratch comes from this thread's workspace
+ * ([b1, e1) - [b2, e2)) => x
+ */
+template<typename I1, typename I2, typename OI, typename R>
+OI minus_digits(I1 b1, I1 e1, I2 b2, I2 e2, OI x, R r) {
+	return minus_digits(b1, e1, b2, e2, x, r, default_workspace());
+}
+
+/**
+ * the sequences are of decimal digits
+ * ([b1, e1) - [b2, e2)) => x
+ */
+template<typename I1, typename I2, typename OI>
+OI minus_digits(I1 b1, I1 e1, I2 b2, I2 e2, OI x) {
+	return minus_digits(b1, e1, b2, e2, x, decimal_radix());
 }
 
 // Multiples
+/**
+ * @param b  an iterator to the beginning of an input  sequence (inclusive)
+ * @param e  an iterator to the end       of an input  sequence (exclusive)
+ * @param d  a single digit in radix r
+ * @param x  an iterator to the beginning of an output sequence (inclusive)
+ * @param r  the radix policy of both sequences
+ * @return   an iterator to the end       of an output sequence (exclusive)
+ * output the product of the input sequence and d into the output sequence,
+ * always writing (e - b) + 1 digits, the leading one possibly zero
+ * ([b, e) * d) => x
+ */
+template<typename BI, typename BO, typename R>
+BO multiplies_digit(BI b, BI e, typename R::wide_type d, BO x, R) {
+	typedef typename R::wide_type wide_type;
+
+	std::advance(x, std::distance(b, e) + 1);
+	BO result = x;
+	wide_type carry = 0;
+	while (b != e) {
+		--e;
+		carry += static_cast<wide_type>(*e) * d;
+		*--x = carry % R::base();
+		carry /= R::base();
+	}
+	*--x = carry;
+	return result;
+}
+
+/**
+ * @param b  an iterator to the beginning of an input  sequence (inclusive)
+ * @param e  an iterator to the end       of an input  sequence (exclusive)
+ * @param d  a divisor small enough that d * r.base() fits the wide type
+ * @param x  an iterator to the beginning of an output sequence (inclusive)
+ * @param r  the radix policy of both sequences
+ * @return   the remainder
+ * output the quotient of the input sequence and d into the output sequence,
+ * always writing (e - b) digits, the leading ones possibly zero
+ * x may be b
+ * ([b, e) / d) => x
+ */
+template<typename II, typename OI, typename R>
+typename R::wide_type divides_digit(II b, II e, typename R::wide_type d, OI x, R) {
+	typedef typename R::wide_type wide_type;
+	assert(d != 0 && "can't divide by zero");
+
+	wide_type remainder = 0;
+	while (b != e) {
+		remainder = remainder * R::base() + *b++;
+		*x++ = remainder / d;
+		remainder %= d;
+	}
+	return remainder;
+}
+
 // bidirectional iterators
 // O(n^2)
-template<typename BI1, typename BI2, typename OI>
-OI multiplies_digits(BI1 b1, BI1 e1, BI2 b2, BI2 e2, OI x, biTag, biTag) {
-	typedef std::vector<typename std::iterator_traits<OI>::value_type> result_list;
-	typedef typename result_list::iterator result_list_iterator;
+template<typename BI1, typename BI2, typename OI, typename R>
+OI multiplies_digits(BI1 b1, BI1 e1, BI2 b2, BI2 e2, OI x, biTag, biTag, R, workspace& w) {
+	typedef typename std::iterator_traits<OI>::value_type result_type;
+	typedef result_type* result_list_iterator;
 	typedef typename std::iterator_traits<BI1>::difference_type dType1;
 	typedef typename std::iterator_traits<BI2>::difference_type dType2;
+	typedef typename R::wide_type wide_type;
 
 	dType1 len1 = std::distance(b1, e1);
 	dType2 len2 = std::distance(b2, e2);
 
-	result_list result(len1 + len2, 0);
-	result_list_iterator startIndex = result.end() - 1;
+	workspace::frame frame(w);
+	result_type* const result = w.allocate<result_type>(len1 + len2);
+	result_list_iterator startIndex = result + (len1 + len2) - 1;
 	const BI2 end_e2 = e2;
-	int carry;
+	wide_type carry;
 
 	while (b1 != e1) {
 		--e1;
@@ -414,22 +1266,23 @@ OI multiplies_digits(BI1 b1, BI1 e1, BI2 b2, BI2 e2, OI x, biTag, biTag) {
 
 		while (b2 != e2) {
 			--e2;
-			carry += *index + (*e1 * *e2);
-			*index = carry % 10;
-			carry /= 10;
+			carry += *index + static_cast<wide_type>(*e1) * *e2;
+			*index = carry % R::base();
+			carry /= R::base();
 			--index;
 		}
 		*index = carry;
 	}
 
-	return print_list(result.begin(), result.end(), x);
+	return print_list(result, result + (len1 + len2), x);
 }
 
 // input iterators
 // O(n^3)
-template<typename II1, typename II2, typename OI>
-OI multiplies_digits(II1 b1, II1 e1, II2 b2, II2 e2, OI x, inTag, inTag) {
-	typedef std::vector<typename std::iterator_traits<OI>::value_type> result_list;
+template<typename II1, typename II2, typename OI, typename R>
+OI multiplies_digits(II1 b1, II1 e1, II2 b2, II2 e2, OI x, inTag, inTag, R, workspace&) {
+	typedef typename R::wide_type wide_type;
+	typedef std::vector<wide_type> result_list;
 	typedef typename result_list::iterator result_list_iterator;
 	typedef typename std::iterator_traits<II1>::difference_type dType1;
 	typedef typename std::iterator_traits<II2>::difference_type dType2;
@@ -445,22 +1298,22 @@ OI multiplies_digits(II1 b1, II1 e1, II2 b2, II2 e2, OI x, inTag, inTag) {
 	// The most significant digit is
 	result_list_iterator startIndex = result.begin() + 1;
 	const II2 start_b2 = b2;
-	int carry;
+	wide_type carry;
 
 	while (b1 != e1) {
 		result_list_iterator index = startIndex;
 		b2 = start_b2;
 		while (b2 != e2) {
 			// Add the current product to this digit
-			*index += *b1 * *b2++;
+			*index += static_cast<wide_type>(*b1) * *b2++;
 
 			// Carry back the excess values
 			carry = 0;
 			result_list_iterator backTrack = index++;
-			while (*backTrack >= 10) {
+			while (*backTrack >= R::base()) {
 				assert(backTrack != result.begin());
-				carry = *backTrack / 10;
-				*backTrack-- %= 10;
+				carry = *backTrack / R::base();
+				*backTrack-- %= R::base();
 				*backTrack += carry;
 			}
 		}
@@ -471,297 +1324,4468 @@ OI multiplies_digits(II1 b1, II1 e1, II2 b2, II2 e2, OI x, inTag, inTag) {
 	return print_list(result.begin(), result.end(), x);
 }
 
-/**
- * @param b  an iterator to the beginning of an input  sequence (inclusive)
- * @param e  an iterator to the end       of an input  sequence (exclusive)
- * @param b2 an iterator to the beginning of an input  sequence (inclusive)
- * @param e2 an iterator to the end       of an input  sequence (exclusive)
- * @param x  an iterator to the beginning of an output sequence (inclusive)
- * @return   an iterator to the end       of an output sequence (exclusive)
- * the sequences are of decimal digits
- * output the product of the two input sequences into the output sequence
- * ([b1, e1) * [b2, e2)) => x
- */
-template<typename I1, typename I2, typename OI>
-OI multiplies_digits(I1 b1, I1 e1, I2 b2, I2 e2, OI x) {
-	typedef typename std::iterator_traits<OI>::value_type result_type;
-	typedef typename std::iterator_traits<I1>::iterator_category iCat1;
-	typedef typename std::iterator_traits<I2>::iterator_category iCat2;
-
-	b1 = strip_zeroes(b1, e1);
-	b2 = strip_zeroes(b2, e2);
-	// Multiply by 0
-	if (b1 == e1 || b2 == e2) {
-		*x++ = 0;
-		return x;
-	}
+// -------
+// Threads
+// -------
 
-	// Multiply by
-	const result_type ONE[] = {1};
-	if ((compare(b1, e1, ONE, ONE + 1) == 0))
-		return print_list(b2, e2, x);
-	if ((compare(b2, e2, ONE, ONE + 1) == 0))
-		return print_list(b1, e1, x);
+/*
+ * Large products fork their independent subproducts, and the NTT its
+ * transforms and butterflies, onto helper threads.  The helpers come out
+ * of one budget shared by the whole process, so nested forks never run
+ * more threads than multiply_threads() in total; a fork that finds the
+ * budget spent runs on the calling thread instead.  The helpers are the
+ * workers of one pool that lives as long as the process, so each keeps
+ * its workspace warm from one fork to the next.
+ */
 
-	return multiplies_digits(b1, e1, b2, e2, x, iCat1(), iCat2());
+/**
+ * The threads a multiplication may use, counting the calling one
+ * Returned by reference so it can be tuned per machine; 1 keeps every
+ * product on the calling thread
+ */
+inline std::size_t& multiply_threads() {
+	static std::size_t threads = 1;
+	return threads;
 }
 
-// Divides
-// Only need input iterators
 /**
- * @param b  an iterator to the beginning of an input  sequence (inclusive)
- * @param e  an iterator to the end       of an input  sequence (exclusive)
- * @param b2 an iterator to the beginning of an input  sequence (inclusive)
- * @param e2 an iterator to the end       of an input  sequence (exclusive)
- * @param x  an iterator to the beginning of an output sequence (inclusive)
- * @return   an iterator to the end       of an output sequence (exclusive)
- * the sequences are of decimal digits
- * output the division of the two input sequences into the output sequence
- * ([b1, e1) / [b2, e2)) => x
+ * Products whose shorter operand has fewer limbs than this stay on one thread
+ * Returned by reference so it can be tuned per machine
  */
-template<typename II1, typename II2, typename OI>
-OI divides_digits(II1 b1, II1 e1, II2 b2, II2 e2, OI x) {
-	typedef typename std::iterator_traits<OI>::value_type result_type;
-	typedef std::deque<result_type> result_list;
-	typedef typename result_list::iterator result_list_iterator;
-	typedef typename std::iterator_traits<II1>::difference_type dType1;
-	typedef typename std::iterator_traits<II2>::difference_type dType2;
-	typedef typename std::iterator_traits<result_list_iterator>::difference_type result_diff;
+inline std::size_t& parallel_threshold() {
+	static std::size_t threshold = 1000;
+	return threshold;
+}
 
-	b1 = strip_zeroes(b1, e1);
-	b2 = strip_zeroes(b2, e2);
+inline std::atomic<std::size_t>& busy_threads() {
+	static std::atomic<std::size_t> busy(0);
+	return busy;
+}
 
-	// zero / anything is zero
-	if (b1 == e1) {
-		*x++ = 0;
-		return x;
+/**
+ * @return how many of the wanted helper threads the budget has left, now taken
+ */
+inline std::size_t claim_threads(std::size_t wanted) {
+	std::atomic<std::size_t>& busy = busy_threads();
+	std::size_t current = busy.load();
+	for (;;) {
+		const std::size_t limit = multiply_threads() > 1 ? multiply_threads() - 1 : 0;
+		if (current >= limit || wanted == 0)
+			return 0;
+		const std::size_t taken = std::min(wanted, limit - current);
+		if (busy.compare_exchange_weak(current, current + taken))
+			return taken;
 	}
-	assert((b2 != e2) && "can't divide by zero");
+}
 
-	int cmp = compare(b1, e1, b2, e2);
-	// Quotient is smaller than dividend
-	if (cmp < 0) {
-		*x = 0;
-		return ++x;
-	}
-	// Quotient is equal to dividend
-	else if (cmp == 0) {
-		*x = 1;
-		return ++x;
-	}
-	const result_type ONE[] = {1};
-	// Dividend is one
-	if (compare(b2, e2, ONE, ONE + 1) == 0){
-		while (b1 != e1)
-			*x++ = *b1++;
-		return x;
-	}
+/**
+ * Gives helper threads back to the budget when it goes out of scope
+ */
+class thread_claim {
+	private:
+		std::size_t count;
+
+		thread_claim(const thread_claim&);
+		thread_claim& operator=(const thread_claim&);
 
-	// General case
-	dType1 qlen = std::distance(b1, e1);
-	dType2 dlen = std::distance(b2, e2);
-	result_list result(1, 0);
-	result_list addSpace(qlen + 1, 0);
-	result_list quotientSpace(qlen, 0);
-	result_list_iterator addEnd;
+	public:
+		explicit thread_claim(std::size_t n) :
+				count(n) {
+		}
 
-	// Copy the dividend so we don't overwrite it
-	std::copy(b1, e1, quotientSpace.begin());
+		~thread_claim() {
+			busy_threads() -= count;
+		}
+};
 
-	// Keep track of the current section of the quotient we're working with
-	result_list_iterator quotientStart = quotientSpace.begin();
-	result_list_iterator quotientEnd = quotientSpace.begin() + dlen - 1;
+/**
+ * Worker threads that run queued tasks, started as the budget needs them
+ * and joined when the process exits
+ * There are never fewer workers than the budget has helpers, so a claimed
+ * task always finds one free, even when every other worker is waiting on
+ * a fork of its own.
+ */
+class thread_pool {
+	private:
+		std::vector<std::thread> workers;
+		std::deque< std::packaged_task<void ()> > tasks;
+		std::mutex lock;
+		std::condition_variable ready;
+		bool stopping;
 
-	// This lines up the dividend with the front of the quotient and performs
-	// good old fashioned long division
-	int counter;
-	while (quotientEnd != quotientSpace.end()) {
-		++quotientEnd;
-		counter = 0;
-		while (compare(quotientStart, quotientEnd, b2, e2) >= 0) {
-			++counter;
-			// Subtract dividend out of quotient
-			addEnd = minus_digits(quotientStart, quotientEnd, b2, e2, addSpace.begin());
+		thread_pool(const thread_pool&);
+		thread_pool& operator=(const thread_pool&);
 
-			// Store the result back into quotient
-			// shifting over when necessary
-			result_list_iterator placeHolder = quotientEnd;
-			while(addEnd != addSpace.begin()) {
-				--addEnd;
-				--placeHolder;
-				*placeHolder = *addEnd;
+		void work() {
+			for (;;) {
+				std::packaged_task<void ()> task;
+				{
+					std::unique_lock<std::mutex> guard(lock);
+					while (!stopping && tasks.empty())
+						ready.wait(guard);
+					if (tasks.empty())
+						return;
+					task = std::move(tasks.front());
+					tasks.pop_front();
+				}
+				task();
 			}
-			quotientStart = strip_zeroes(placeHolder, quotientEnd);
 		}
-		result.push_back(counter);
-	}
-
-	return print_list(result.begin(), result.end(), x);
-}
 
-template<typename T, typename C = std::vector<T> >
-class Integer {
-		/**
-		 * Returns content equality
-		 */
-		friend bool operator ==(const Integer& lhs, const Integer& rhs) {
-			return lhs.positive == rhs.positive && lhs.data.size() == rhs.data.size()
-			       && std::equal(lhs.data.begin(), lhs.data.end(), rhs.data.begin());
+	public:
+		thread_pool() :
+				stopping(false) {
 		}
 
-		/**
-		 * Returns the negation of content equality
-		 */
-		friend bool operator !=(const Integer& lhs, const Integer& rhs) {
-			return !(lhs == rhs);
+		~thread_pool() {
+			{
+				std::unique_lock<std::mutex> guard(lock);
+				stopping = true;
+			}
+			ready.notify_all();
+			for (std::size_t i = 0; i < workers.size(); ++i)
+				workers[i].join();
 		}
 
 		/**
-		 * Returns true if the value of lhs is less than rhs
-		 * False otherwise
+		 * Queues task for a worker, first starting workers up to the
+		 * helpers multiply_threads() allows
+		 * @return the future of task
+		 * @throws system_error if a worker could not be started, before
+		 * anything is queued
 		 */
-		friend bool operator <(const Integer& lhs, const Integer& rhs) {
-			// Easy +/- testing
-			if (lhs.positive != rhs.positive)
-				return !lhs.positive;
-
-			int cmp = compare(lhs.data.begin(), lhs.data.end(), rhs.data.begin(), rhs.data.end());
-			if (lhs.positive) {
-				assert(rhs.positive);
-				return cmp < 0;
-			}
-			else {
-				return cmp > 0;
+		template<typename F>
+		std::future<void> submit(F task) {
+			std::packaged_task<void ()> job(task);
+			std::future<void> result = job.get_future();
+			{
+				std::unique_lock<std::mutex> guard(lock);
+				while (workers.size() + 1 < multiply_threads())
+					workers.push_back(std::thread(&thread_pool::work, this));
+				tasks.push_back(std::move(job));
 			}
+			ready.notify_one();
+			return result;
 		}
+};
 
-		/**
-		 * Returns true if the value of lhs is less than or equal to rhs
-		 * false otherwise
-		 */
-		friend bool operator <=(const Integer& lhs, const Integer& rhs) {
-			return !(rhs < lhs);
-		}
+/**
+ * The pool every fork draws its helpers from
+ */
+inline thread_pool& helper_pool() {
+	static thread_pool pool;
+	return pool;
+}
 
-		/**
-		 * Returns true if the value of lhs is greater than rhs
-		 * false otherwise
-		 */
-		friend bool operator >(const Integer& lhs, const Integer& rhs) {
-			return (rhs < lhs);
-		}
+/**
+ * A fork and join of tasks that take the workspace to draw scratch from
+ * Each task goes to a pool worker, with that worker's workspace, while
+ * the group may fork and the budget has one, and otherwise runs right away
+ * on the calling thread with the group's.  wait() joins them all and
+ * rethrows the first exception a helper threw.
+ */
+class task_group {
+	private:
+		workspace& owner;
+		bool fork;
+		std::vector< std::future<void> > helpers;
 
-		/**
-		 * Returns true if lhs is greater than or equal to rhs
-		 */
-		friend bool operator >=(const Integer& lhs, const Integer& rhs) {
-			return !(lhs < rhs);
-		}
+		task_group(const task_group&);
+		task_group& operator=(const task_group&);
 
-		/**
-		 * Returns a new Integer with the sum of lhs and rhs
-		 */
-		friend Integer operator +(Integer lhs, const Integer& rhs) {
-			return lhs += rhs;
-		}
+		template<typename F>
+		struct helper {
+			F task;
 
-		/**
-		 * Returns a new Integer wth teh value of rhs subtracted from rhs
-		 */
-		friend Integer operator -(Integer lhs, const Integer& rhs) {
-			return lhs -= rhs;
-		}
+			void operator () () {
+				thread_claim claim(1);
+				task(default_workspace());
+			}
+		};
 
-		/**
-		 * Returns a new Integer with the product of lhs and rhs
-		 */
-		friend Integer operator *(Integer lhs, const Integer& rhs) {
-			return lhs *= rhs;
+	public:
+		task_group(workspace& w, bool f) :
+				owner(w),
+				fork(f) {
 		}
 
-		/**
-		 * Returns a new Integer with the value of lhs divided by rhs
-		 *
-		 * @throws invalid_argument if (rhs == 0)
-		 */
-		friend Integer operator /(Integer lhs, const Integer& rhs) {
-			return lhs /= rhs;
+		// Helpers still running are joined by their futures
+		~task_group() {
+			for (std::size_t i = 0; i < helpers.size(); ++i) {
+				if (helpers[i].valid())
+					helpers[i].wait();
+			}
 		}
 
-		/**
-		 * Returns the remainder of lhs divided by rhs
-		 *
-		 * @throws invalid_argument if (rhs <= 0)
-		 */
-		friend Integer operator %(Integer lhs, const Integer& rhs) {
-			return lhs %= rhs;
+		template<typename F>
+		void run(F task) {
+			if (fork && claim_threads(1) == 1) {
+				const helper<F> h = {task};
+				try {
+					helpers.push_back(helper_pool().submit(h));
+					return;
+				}
+				catch (const std::system_error&) {
+					busy_threads() -= 1;
+				}
+			}
+			task(owner);
 		}
 
-		/**
-		 * Returns a new Integer with the value of lhs shifted rhs bits left
-		 *
-		 * @throws invalid_argument if (rhs < 0)
-		 */
-		friend Integer operator <<(Integer lhs, int rhs) {
-			return lhs <<= rhs;
+		void wait() {
+			for (std::size_t i = 0; i < helpers.size(); ++i)
+				helpers[i].get();
+			helpers.clear();
 		}
+};
 
-		/**
-		 * Returns a new Integer with the value of lhs shifted rhs bits right
-		 *
-		 * @throws invalid_argument if (rhs < 0)
-		 */
-		friend Integer operator >>(Integer lhs, int rhs) {
-			return lhs >>= rhs;
-		}
+/**
+ * Calls f(i, j) on pieces [i, j) that cover [first, last), one on the
+ * calling thread and one on every helper thread the budget has left, with
+ * no piece smaller than grain
+ */
+template<typename F>
+void parallel_for(std::size_t first, std::size_t last, std::size_t grain, F f) {
+	const std::size_t pieces = (last - first) / std::max<std::size_t>(grain, 1);
+	const std::size_t helpers = pieces > 1 ? claim_threads(pieces - 1) : 0;
+	if (helpers == 0) {
+		f(first, last);
+		return;
+	}
 
-		/**
-		 * Prints this Integer to lhs
-		 */
-		friend std::ostream& operator <<(std::ostream& lhs, const Integer& rhs) {
-			if (!rhs.positive)
-				lhs << "-";
-			for (C_const_iter i = rhs.data.begin(); i != rhs.data.end(); ++i)
-				lhs << *i;
-			return lhs;
+	thread_claim claim(helpers);
+	const std::size_t step = (last - first + helpers) / (helpers + 1);
+	std::vector< std::future<void> > running;
+	std::size_t rest = last;
+	for (std::size_t i = first + step; i < last; i += step) {
+		const std::size_t end = std::min(last, i + step);
+		try {
+			running.push_back(helper_pool().submit([&f, i, end] () {
+				f(i, end);
+			}));
 		}
-
-		/**
-		 * Returns a new Integer with the absolute value of x
-		 */
-		friend Integer abs(Integer x) {
-			return x.abs();
+		catch (const std::system_error&) {
+			rest = i;
+			break;
 		}
+	}
 
-		/**
-		 * Returns a new Integer with the value of x raised to the e power
-		 *
-		 * @throws invalid_argument if (x == 0) && (e == 0)
-		 * @throws invalid_argument if (e < 0)
-		 */
-		friend Integer pow(Integer x, int e) {
-			return x.pow(e);
-		}
+	// Pool futures don't wait when destroyed, and the pieces use f
+	try {
+		f(first, first + step);
+		if (rest < last)
+			f(rest, last);
+	}
+	catch (...) {
+		for (std::size_t i = 0; i < running.size(); ++i)
+			running[i].wait();
+		throw;
+	}
+	for (std::size_t i = 0; i < running.size(); ++i)
+		running[i].wait();
+	for (std::size_t i = 0; i < running.size(); ++i)
+		running[i].get();
+}
 
-	private:
-		// Typedefs
-		typedef typename C::iterator C_iter;
-		typedef typename C::const_iterator C_const_iter;
-		typedef typename std::iterator_traits<C_iter>::difference_type C_diff_t;
-		typedef T* pointer;
+// ---------
+// Karatsuba
+// ---------
 
-		// data
-		C data;
-		bool positive;
+/*
+ * The subquadratic multiplies work on little endian arrays, least
+ * significant digit first, so splitting a number in half is pointer math.
+ * The random access multiplies_digits copies its operands into that layout.
+ */
+
+/**
+ * @return the number of digits of [a, a + n) without its leading zeroes
+ */
+template<typename T>
+std::size_t significant_limbs(const T* a, std::size_t n) {
+	while (n > 0 && a[n - 1] == 0)
+		--n;
+	return n;
+}
+
+/**
+ * [a, a + na) + [b, b + nb) => [r, r + na), na >= nb
+ * r may be a or b
+ * @return the carry out of the top digit
+ */
+template<typename T, typename R>
+T plus_limbs(const T* a, std::size_t na, const T* b, std::size_t nb, T* r, R radix) {
+	typedef typename R::wide_type wide_type;
+	assert(na >= nb);
+
+	unsigned laneCarry = 0;
+	std::size_t i = 0;
+	if (lanes_fit<T>(radix))
+		i = plus_lanes<false>(reinterpret_cast<const int*>(a), reinterpret_cast<const int*>(b), reinterpret_cast<int*>(r), nb, static_cast<int>(R::base()), laneCarry);
+
+	wide_type carry = laneCarry;
+	for (; i < nb; ++i) {
+		carry += static_cast<wide_type>(a[i]) + b[i];
+		r[i] = carry % R::base();
+		carry /= R::base();
+	}
+	for (; i < na; ++i) {
+		carry += a[i];
+		r[i] = carry % R::base();
+		carry /= R::base();
+	}
+	return carry;
+}
+
+/**
+ * [a, a + na) - [b, b + nb) => [r, r + na), na >= nb
+ * r may be a or b
+ * @return the borrow out of the top digit
+ */
+template<typename T, typename R>
+T minus_limbs(const T* a, std::size_t na, const T* b, std::size_t nb, T* r, R radix) {
+	typedef typename R::signed_wide_type signed_wide_type;
+	assert(na >= nb);
+
+	unsigned borrow = 0;
+	std::size_t i = 0;
+	if (lanes_fit<T>(radix))
+		i = minus_lanes<false>(reinterpret_cast<const int*>(a), reinterpret_cast<const int*>(b), reinterpret_cast<int*>(r), nb, static_cast<int>(R::base()), borrow);
+
+	signed_wide_type difference = -static_cast<signed_wide_type>(borrow);
+	for (; i < na; ++i) {
+		difference += a[i];
+		if (i < nb)
+			difference -= b[i];
+		if (difference < 0) {
+			r[i] = difference + R::base();
+			difference = -1;
+		}
+		else {
+			r[i] = difference;
+			difference = 0;
+		}
+	}
+	return difference != 0;
+}
+
+/**
+ * [a, a + na) * [b, b + nb) => [r, r + na + nb)
+ * O(na * nb)
+ */
+template<typename T, typename R>
+void multiplies_limbs_schoolbook(const T* a, std::size_t na, const T* b, std::size_t nb, T* r, R) {
+	typedef typename R::wide_type wide_type;
+
+	std::fill(r, r + na + nb, 0);
+	for (std::size_t i = 0; i < na; ++i) {
+		wide_type carry = 0;
+		for (std::size_t j = 0; j < nb; ++j) {
+			carry += r[i + j] + static_cast<wide_type>(a[i]) * b[j];
+			r[i + j] = carry % R::base();
+			carry /= R::base();
+		}
+		r[i + nb] = carry;
+	}
+}
+
+/**
+ * [a, a + n) * [a, a + n) => [r, r + 2n)
+ * Works out each cross product a[i] * a[j], i < j, once and doubles them
+ * before adding the squares on the diagonal, about half the work of
+ * multiplies_limbs_schoolbook
+ * O(n^2)
+ */
+template<typename T, typename R>
+void square_limbs_schoolbook(const T* a, std::size_t n, T* r, R) {
+	typedef typename R::wide_type wide_type;
+
+	std::fill(r, r + 2 * n, 0);
+	for (std::size_t i = 0; i < n; ++i) {
+		wide_type carry = 0;
+		for (std::size_t j = i + 1; j < n; ++j) {
+			carry += r[i + j] + static_cast<wide_type>(a[i]) * a[j];
+			r[i + j] = carry % R::base();
+			carry /= R::base();
+		}
+		r[i + n] = carry;
+	}
+
+	wide_type carry = 0;
+	for (std::size_t i = 0; i < n; ++i) {
+		const wide_type square = static_cast<wide_type>(a[i]) * a[i];
+		carry += static_cast<wide_type>(r[2 * i]) + r[2 * i] + square % R::base();
+		r[2 * i] = carry % R::base();
+		carry /= R::base();
+		carry += static_cast<wide_type>(r[2 * i + 1]) + r[2 * i + 1] + square / R::base();
+		r[2 * i + 1] = carry % R::base();
+		carry /= R::base();
+	}
+	assert(carry == 0);
+}
+
+/**
+ * Operands with fewer digits than this use the schoolbook kernel
+ * Returned by reference so it can be tuned per machine
+ */
+inline std::size_t& karatsuba_threshold() {
+	static std::size_t threshold = 48;
+	return threshold;
+}
+
+/**
+ * Operands with at least this many digits use Toom-3 instead of Karatsuba
+ * Returned by reference so it can be tuned per machine
+ */
+inline std::size_t& toom3_threshold() {
+	static std::size_t threshold = 200;
+	return threshold;
+}
+
+template<typename T, typename R>
+void multiplies_limbs(const T* a, std::size_t na, const T* b, std::size_t nb, T* r, R radix, workspace& w);
+
+/**
+ * [a, a + na) * [b, b + nb) => [r, r + na + nb), na >= nb > na / 2
+ * Splits both operands at half of the longer one:
+ * a * b = z2 * B^2m + ((a0 + a1)(b0 + b1) - z2 - z0) * B^m + z0
+ * O(n^1.585)
+ */
+template<typename T, typename R>
+void karatsuba_limbs(const T* a, std::size_t na, const T* b, std::size_t nb, T* r, R radix, workspace& w) {
+	const std::size_t m = na / 2;
+	const T* a0 = a;
+	const T* a1 = a + m;
+	const T* b0 = b;
+	const T* b1 = b + m;
+	const std::size_t na1 = na - m;
+	const std::size_t nb1 = nb - m;
+
+	// z0 and z2 go straight to their places in the result, on helper
+	// threads while z1 is worked out when the operands are long enough
+	task_group group(w, nb >= parallel_threshold());
+	group.run([=](workspace& tw) {
+		multiplies_limbs(a0, m, b0, m, r, radix, tw);
+	});
+	group.run([=](workspace& tw) {
+		multiplies_limbs(a1, na1, b1, nb1, r + 2 * m, radix, tw);
+	});
+
+	workspace::frame frame(w);
+	T* const sumA = w.allocate<T>(na1 + 1);
+	sumA[na1] = plus_limbs(a1, na1, a0, m, sumA, radix);
+	std::size_t lengthA = significant_limbs(sumA, na1 + 1);
+
+	// A square squares the one sum, so z1 stays a square too
+	T* sumB = sumA;
+	std::size_t lengthB = lengthA;
+	if (a != b || na != nb) {
+		const std::size_t nSumB = std::max(m, nb1) + 1;
+		sumB = w.allocate<T>(nSumB);
+		if (nb1 >= m)
+			sumB[nb1] = plus_limbs(b1, nb1, b0, m, sumB, radix);
+		else
+			sumB[m] = plus_limbs(b0, m, b1, nb1, sumB, radix);
+		lengthB = significant_limbs(sumB, nSumB);
+	}
+
+	T* const z1 = w.allocate<T>(lengthA + lengthB + 1);
+	multiplies_limbs(sumA, lengthA, sumB, lengthB, z1, radix, w);
+	group.wait();
+	std::size_t length = significant_limbs(z1, lengthA + lengthB + 1);
+	minus_limbs(z1, length, r, significant_limbs(r, 2 * m), z1, radix);
+	length = significant_limbs(z1, length);
+	minus_limbs(z1, length, r + 2 * m, significant_limbs(r + 2 * m, na1 + nb1), z1, radix);
+	length = significant_limbs(z1, length);
+
+	T carry = plus_limbs(r + m, na + nb - m, z1, length, r + m, radix);
+	assert(carry == 0);
+	(void) carry;
+}
+
+// -------
+// Toom-3
+// -------
+
+/**
+ * A little endian magnitude without leading zeroes and its sign
+ * Toom-3 evaluates at -1 and -2, so its intermediate values can go negative
+ */
+template<typename T>
+struct signed_limbs {
+	std::vector<T> digits;
+	bool negative;
+
+	signed_limbs() :
+			negative(false) {
+	}
+
+	signed_limbs(const T* a, std::size_t n) :
+			digits(a, a + significant_limbs(a, n)),
+			negative(false) {
+	}
+};
+
+/**
+ * @return 1, 0 or -1 as [a, a + na) is greater, equal or less than [b, b + nb)
+ */
+template<typename T>
+int compare_limbs(const T* a, std::size_t na, const T* b, std::size_t nb) {
+	na = significant_limbs(a, na);
+	nb = significant_limbs(b, nb);
+	if (na != nb)
+		return na > nb ? 1 : -1;
+	while (na-- > 0) {
+		if (a[na] != b[na])
+			return a[na] > b[na] ? 1 : -1;
+	}
+	return 0;
+}
+
+/**
+ * @return x + y, or x - y when subtract is set
+ */
+template<typename T, typename R>
+signed_limbs<T> plus_signed_limbs(const signed_limbs<T>& x, const signed_limbs<T>& y, bool subtract, R radix) {
+	const std::vector<T>& a = x.digits;
+	const std::vector<T>& b = y.digits;
+	const bool yNegative = y.negative != subtract;
+	signed_limbs<T> result;
+
+	if (x.negative == yNegative) {
+		const std::vector<T>& longer = a.size() >= b.size() ? a : b;
+		const std::vector<T>& shorter = a.size() >= b.size() ? b : a;
+		result.digits.resize(longer.size() + 1);
+		if (!longer.empty())
+			result.digits[longer.size()] = plus_limbs(&longer[0], longer.size(), shorter.empty() ? 0 : &shorter[0], shorter.size(), &result.digits[0], radix);
+		result.negative = x.negative;
+	}
+	else {
+		int cmp = compare_limbs(a.empty() ? 0 : &a[0], a.size(), b.empty() ? 0 : &b[0], b.size());
+		if (cmp == 0)
+			return result;
+		const std::vector<T>& larger = cmp > 0 ? a : b;
+		const std::vector<T>& smaller = cmp > 0 ? b : a;
+		result.digits.resize(larger.size());
+		minus_limbs(&larger[0], larger.size(), smaller.empty() ? 0 : &smaller[0], smaller.size(), &result.digits[0], radix);
+		result.negative = cmp > 0 ? x.negative : yNegative;
+	}
+	result.digits.resize(significant_limbs(&result.digits[0], result.digits.size()));
+	if (result.digits.empty())
+		result.negative = false;
+	return result;
+}
+
+/**
+ * @return x * y
+ */
+template<typename T, typename R>
+signed_limbs<T> multiplies_signed_limbs(const signed_limbs<T>& x, const signed_limbs<T>& y, R radix, workspace& w) {
+	signed_limbs<T> result;
+	if (x.digits.empty() || y.digits.empty())
+		return result;
+	result.digits.resize(x.digits.size() + y.digits.size());
+	multiplies_limbs(&x.digits[0], x.digits.size(), &y.digits[0], y.digits.size(), &result.digits[0], radix, w);
+	result.digits.resize(significant_limbs(&result.digits[0], result.digits.size()));
+	result.negative = x.negative != y.negative;
+	return result;
+}
+
+/**
+ * x / d for a small d that divides x exactly
+ */
+template<typename T, typename R>
+void divides_exact_signed_limbs(signed_limbs<T>& x, typename R::wide_type d, R) {
+	typedef typename R::wide_type wide_type;
+
+	wide_type remainder = 0;
+	for (std::size_t i = x.digits.size(); i-- > 0;) {
+		remainder = remainder * R::base() + x.digits[i];
+		x.digits[i] = remainder / d;
+		remainder %= d;
+	}
+	assert(remainder == 0);
+	x.digits.resize(x.digits.empty() ? 0 : significant_limbs(&x.digits[0], x.digits.size()));
+}
+
+/**
+ * Evaluates p(x) = p2 x^2 + p1 x + p0 at 1, -1 and -2
+ */
+template<typename T, typename R>
+void toom3_evaluate(const signed_limbs<T>& p0, const signed_limbs<T>& p1, const signed_limbs<T>& p2,
+                    signed_limbs<T>& at1, signed_limbs<T>& atMinus1, signed_limbs<T>& atMinus2, R radix) {
+	signed_limbs<T> sum = plus_signed_limbs(p0, p2, false, radix);
+	at1 = plus_signed_limbs(sum, p1, false, radix);
+	atMinus1 = plus_signed_limbs(sum, p1, true, radix);
+	atMinus2 = plus_signed_limbs(atMinus1, p2, false, radix);
+	atMinus2 = plus_signed_limbs(atMinus2, atMinus2, false, radix);
+	atMinus2 = plus_signed_limbs(atMinus2, p0, true, radix);
+}
+
+/**
+ * [a, a + na) * [b, b + nb) => [r, r + na + nb), both split into three parts
+ * Evaluates at 0, 1, -1, -2 and infinity, multiplies the five points and
+ * interpolates with Bodrato's sequence
+ * When a and b are the same limbs the points are squared
+ * O(n^1.465)
+ */
+template<typename T, typename R>
+void toom3_limbs(const T* a, std::size_t na, const T* b, std::size_t nb, T* r, R radix, workspace& w) {
+	const std::size_t k = (na + 2) / 3;
+	assert(nb > 2 * k);
+
+	// A square evaluates its one operand and squares the points
+	const bool square = a == b && na == nb;
+	const signed_limbs<T> a0(a, k), a1(a + k, k), a2(a + 2 * k, na - 2 * k);
+	signed_limbs<T> a1Point, aMinus1Point, aMinus2Point;
+	toom3_evaluate(a0, a1, a2, a1Point, aMinus1Point, aMinus2Point, radix);
+	signed_limbs<T> b0, b1, b2, b1Point, bMinus1Point, bMinus2Point;
+	if (!square) {
+		b0 = signed_limbs<T>(b, k);
+		b1 = signed_limbs<T>(b + k, k);
+		b2 = signed_limbs<T>(b + 2 * k, nb - 2 * k);
+		toom3_evaluate(b0, b1, b2, b1Point, bMinus1Point, bMinus2Point, radix);
+	}
+	const signed_limbs<T>* const x[] = {&a0, &a1Point, &aMinus1Point, &aMinus2Point, &a2};
+	const signed_limbs<T>* const y[] = {&b0, &b1Point, &bMinus1Point, &bMinus2Point, &b2};
+	const signed_limbs<T>* const* const z = square ? x : y;
+
+	// The five point products are independent, so all but the last may go
+	// to helper threads
+	signed_limbs<T> points[5];
+	task_group group(w, nb >= parallel_threshold());
+	for (std::size_t i = 0; i < 4; ++i) {
+		group.run([&, i](workspace& tw) {
+			points[i] = multiplies_signed_limbs(*x[i], *z[i], radix, tw);
+		});
+	}
+	points[4] = multiplies_signed_limbs(*x[4], *z[4], radix, w);
+	group.wait();
+	signed_limbs<T>& r0 = points[0];
+	signed_limbs<T>& r1 = points[1];
+	signed_limbs<T>& r2 = points[2];
+	signed_limbs<T>& r3 = points[3];
+	const signed_limbs<T>& r4 = points[4];
+
+	// Interpolation
+	r3 = plus_signed_limbs(r3, r1, true, radix);
+	divides_exact_signed_limbs(r3, 3, radix);
+	r1 = plus_signed_limbs(r1, r2, true, radix);
+	divides_exact_signed_limbs(r1, 2, radix);
+	r2 = plus_signed_limbs(r2, r0, true, radix);
+	r3 = plus_signed_limbs(r2, r3, true, radix);
+	divides_exact_signed_limbs(r3, 2, radix);
+	r3 = plus_signed_limbs(r3, r4, false, radix);
+	r3 = plus_signed_limbs(r3, r4, false, radix);
+	r2 = plus_signed_limbs(r2, r1, false, radix);
+	r2 = plus_signed_limbs(r2, r4, true, radix);
+	r1 = plus_signed_limbs(r1, r3, true, radix);
+
+	// Recomposition, every coefficient of the product is non-negative
+	const signed_limbs<T>* coefficients[] = {&r0, &r1, &r2, &r3, &r4};
+	std::fill(r, r + na + nb, 0);
+	for (std::size_t i = 0; i < 5; ++i) {
+		const std::vector<T>& c = coefficients[i]->digits;
+		assert(!coefficients[i]->negative);
+		if (c.empty())
+			continue;
+		T carry = plus_limbs(r + i * k, na + nb - i * k, &c[0], c.size(), r + i * k, radix);
+		assert(carry == 0);
+		(void) carry;
+	}
+}
+
+// ---
+// NTT
+// ---
+
+/**
+ * Operands with at least this many limbs are multiplied by number
+ * theoretic transforms instead of Toom-3, decimal digits count nine to a limb
+ * Returned by reference so it can be tuned per machine
+ */
+inline std::size_t& ntt_threshold() {
+	static std::size_t threshold = 8000;
+	return threshold;
+}
+
+/**
+ * @return b^e mod p
+ */
+inline unsigned long long power_mod(unsigned long long b, unsigned long long e, unsigned long long p) {
+	unsigned long long result = 1;
+	b %= p;
+	while (e != 0) {
+		if ((e & 1) == 1)
+			result = result * b % p;
+		b = b * b % p;
+		e >>= 1;
+	}
+	return result;
+}
+
+// The butterflies and products an NTT helper thread gets at the least
+const std::size_t NTT_GRAIN = static_cast<std::size_t>(1) << 14;
+
+/**
+ * In place transform of a modulo the prime P with primitive root G
+ * a.size() has to be a power of two dividing P - 1
+ * P < 2^30, so the product of two residues fits in 64 bits
+ * The butterflies of each stage are independent, so with parallel they are
+ * shared out among helper threads
+ * O(n log n)
+ */
+template<unsigned P, unsigned G>
+void ntt(std::vector<unsigned>& a, bool inverse, bool parallel) {
+	typedef unsigned long long ull;
+	const std::size_t n = a.size();
+	const std::size_t grain = parallel ? NTT_GRAIN : n;
+
+	// Bit reversal permutation
+	for (std::size_t i = 1, j = 0; i < n; ++i) {
+		std::size_t bit = n >> 1;
+		for (; (j & bit) != 0; bit >>= 1)
+			j ^= bit;
+		j ^= bit;
+		if (i < j)
+			std::swap(a[i], a[j]);
+	}
+
+	std::vector<unsigned> roots(std::max<std::size_t>(n / 2, 1));
+	for (std::size_t length = 2; length <= n; length <<= 1) {
+		const std::size_t half = length / 2;
+		ull w = power_mod(G, (P - 1) / length, P);
+		if (inverse)
+			w = power_mod(w, P - 2, P);
+		roots[0] = 1;
+		for (std::size_t k = 1; k < half; ++k)
+			roots[k] = static_cast<ull>(roots[k - 1]) * w % P;
+
+		// Butterfly t is number t % half of block t / half
+		parallel_for(0, n / 2, grain, [&](std::size_t first, std::size_t last) {
+			for (std::size_t t = first; t < last; ) {
+				const std::size_t i = t / half * length;
+				const std::size_t end = std::min(half, t % half + (last - t));
+				for (std::size_t k = t % half; k < end; ++k, ++t) {
+					const unsigned u = a[i + k];
+					const unsigned v = static_cast<ull>(a[i + k + half]) * roots[k] % P;
+					a[i + k] = u + v < P ? u + v : u + v - P;
+					a[i + k + half] = u >= v ? u - v : u + P - v;
+				}
+			}
+		});
+	}
+
+	if (inverse) {
+		const ull scale = power_mod(n, P - 2, P);
+		parallel_for(0, n, grain, [&](std::size_t first, std::size_t last) {
+			for (std::size_t i = first; i < last; ++i)
+				a[i] = a[i] * scale % P;
+		});
+	}
+}
+
+/**
+ * Cyclic convolution of a and b modulo P, the result is left in a
+ * An empty b convolves a with itself, transforming it just once
+ * With parallel the two forward transforms run side by side
+ */
+template<unsigned P, unsigned G>
+void ntt_convolve(std::vector<unsigned>& a, std::vector<unsigned> b, bool parallel) {
+	const bool square = b.empty();
+	task_group group(default_workspace(), parallel);
+	if (!square) {
+		group.run([&](workspace&) {
+			ntt<P, G>(b, false, parallel);
+		});
+	}
+	ntt<P, G>(a, false, parallel);
+	group.wait();
+
+	const std::vector<unsigned>& c = square ? a : b;
+	parallel_for(0, a.size(), parallel ? NTT_GRAIN : a.size(), [&](std::size_t first, std::size_t last) {
+		for (std::size_t i = first; i < last; ++i)
+			a[i] = static_cast<unsigned long long>(a[i]) * c[i] % P;
+	});
+	ntt<P, G>(a, true, parallel);
+}
+
+// The two primes, c * 2^k + 1 with 3 as a primitive root
+// Transforms up to 2^25 points, and their product bounds every coefficient
+// of a convolution of that length with inputs below 2^16
+const unsigned NTT_PRIME_1 = 469762049;  // 7 * 2^26 + 1
+const unsigned NTT_PRIME_2 = 167772161;  // 5 * 2^25 + 1
+const std::size_t NTT_MAX_LENGTH = static_cast<std::size_t>(1) << 25;
+
+/**
+ * Radix R digits are packed into NTT coefficients below 2^16: small digits
+ * several to a coefficient, large limbs split across several, e.g. 2^32
+ * limbs into two 2^16 coefficients and 10^9 limbs into three 10^3 ones
+ */
+template<typename R>
+struct ntt_packing {
+	typedef typename R::wide_type wide_type;
+
+	wide_type coefficientBase;
+	std::size_t digitsPerCoefficient;
+	std::size_t coefficientsPerDigit;
+
+	ntt_packing() :
+			coefficientBase(R::base()),
+			digitsPerCoefficient(1),
+			coefficientsPerDigit(1) {
+		const wide_type LIMIT = 65536;
+		if (R::base() <= LIMIT) {
+			while (coefficientBase * R::base() <= LIMIT) {
+				coefficientBase *= R::base();
+				++digitsPerCoefficient;
+			}
+		}
+		else {
+			// The smallest k with base = c^k for a whole c below the limit
+			for (coefficientsPerDigit = 2; ; ++coefficientsPerDigit) {
+				coefficientBase = static_cast<wide_type>(pow(static_cast<double>(R::base()), 1.0 / coefficientsPerDigit) + 0.5);
+				assert(coefficientBase > 1);
+				wide_type power = 1;
+				for (std::size_t k = 0; k < coefficientsPerDigit; ++k)
+					power *= coefficientBase;
+				if (coefficientBase <= LIMIT && power == R::base())
+					break;
+			}
+		}
+	}
+
+	std::size_t coefficients(std::size_t digits) const {
+		return (digits + digitsPerCoefficient - 1) / digitsPerCoefficient * coefficientsPerDigit;
+	}
+};
+
+/**
+ * Splits the little endian digits [a, a + n) into coefficients
+ */
+template<typename T, typename R>
+void ntt_pack(const T* a, std::size_t n, const ntt_packing<R>& packing, std::vector<unsigned>& c) {
+	typedef typename R::wide_type wide_type;
+
+	std::size_t j = 0;
+	if (packing.coefficientsPerDigit == 1) {
+		for (std::size_t i = 0; i < n; i += packing.digitsPerCoefficient) {
+			wide_type coefficient = 0;
+			std::size_t top = std::min(n, i + packing.digitsPerCoefficient);
+			while (top-- > i)
+				coefficient = coefficient * R::base() + a[top];
+			c[j++] = static_cast<unsigned>(coefficient);
+		}
+	}
+	else {
+		for (std::size_t i = 0; i < n; ++i) {
+			wide_type digit = a[i];
+			for (std::size_t k = 0; k < packing.coefficientsPerDigit; ++k) {
+				c[j++] = static_cast<unsigned>(digit % packing.coefficientBase);
+				digit /= packing.coefficientBase;
+			}
+		}
+	}
+}
+
+/**
+ * [a, a + na) * [b, b + nb) => [r, r + na + nb)
+ * Packs both into coefficients, convolves them modulo two primes,
+ * recombines each coefficient by the Chinese remainder theorem and
+ * propagates the carries back into radix R
+ * O(n log n)
+ */
+template<typename T, typename R>
+void ntt_limbs(const T* a, std::size_t na, const T* b, std::size_t nb, T* r, R) {
+	typedef unsigned long long ull;
+	typedef typename R::wide_type wide_type;
+
+	const ntt_packing<R> packing;
+	const std::size_t ca = packing.coefficients(na);
+	const std::size_t cb = packing.coefficients(nb);
+	std::size_t length = 1;
+	while (length < ca + cb)
+		length <<= 1;
+	assert(length <= NTT_MAX_LENGTH);
+
+	// A square leaves fb empty and transforms fa alone
+	std::vector<unsigned> fa(length, 0);
+	std::vector<unsigned> fb;
+	ntt_pack(a, na, packing, fa);
+	if (a != b || na != nb) {
+		fb.resize(length, 0);
+		ntt_pack(b, nb, packing, fb);
+	}
+
+	// The convolutions modulo each prime are independent
+	const bool parallel = nb >= parallel_threshold();
+	std::vector<unsigned> residues1(fa);
+	task_group group(default_workspace(), parallel);
+	group.run([&](workspace&) {
+		ntt_convolve<NTT_PRIME_1, 3>(residues1, fb, parallel);
+	});
+	ntt_convolve<NTT_PRIME_2, 3>(fa, fb, parallel);
+	group.wait();
+	std::vector<unsigned>& residues2 = fa;
+
+	// x = r1 + p1 * ((r2 - r1) / p1 mod p2), below p1 * p2 < 2^57
+	const ull P1_INVERSE = power_mod(NTT_PRIME_1, NTT_PRIME_2 - 2, NTT_PRIME_2);
+	const ull coefficientBase = packing.coefficientBase;
+	std::vector<T> digits(packing.coefficientsPerDigit == 1 ? length * packing.digitsPerCoefficient : length / packing.coefficientsPerDigit + 1, 0);
+	ull carry = 0;
+	std::size_t digit = 0;
+	wide_type limb = 0;
+	wide_type limbScale = 1;
+	for (std::size_t i = 0; i < length; ++i) {
+		const ull r1 = residues1[i];
+		const ull r2 = residues2[i];
+		const ull t = (r2 + NTT_PRIME_2 - r1 % NTT_PRIME_2) % NTT_PRIME_2 * P1_INVERSE % NTT_PRIME_2;
+		carry += r1 + NTT_PRIME_1 * t;
+		ull coefficient = carry % coefficientBase;
+		carry /= coefficientBase;
+
+		if (packing.coefficientsPerDigit == 1) {
+			for (std::size_t k = 0; k < packing.digitsPerCoefficient; ++k) {
+				digits[digit++] = coefficient % R::base();
+				coefficient /= R::base();
+			}
+		}
+		else {
+			limb += limbScale * coefficient;
+			limbScale *= coefficientBase;
+			if ((i + 1) % packing.coefficientsPerDigit == 0) {
+				digits[digit++] = limb;
+				limb = 0;
+				limbScale = 1;
+			}
+		}
+	}
+	assert(carry == 0);
+	assert(significant_limbs(&digits[0], digits.size()) <= na + nb);
+	std::copy(digits.begin(), digits.begin() + (na + nb), r);
+}
+
+/**
+ * [a, a + na) * [b, b + nb) => [r, r + na + nb)
+ * Picks schoolbook, Karatsuba, Toom-3 or NTT by the size of the shorter operand
+ * a and b may be the same limbs, every tier then squares
+ * Long operands against short ones are cut into balanced pieces first,
+ * unless the whole product fits in one transform
+ */
+template<typename T, typename R>
+void multiplies_limbs(const T* a, std::size_t na, const T* b, std::size_t nb, T* r, R radix, workspace& w) {
+	if (na < nb) {
+		std::swap(a, b);
+		std::swap(na, nb);
+	}
+
+	if (nb < karatsuba_threshold()) {
+		if (a == b && na == nb)
+			square_limbs_schoolbook(a, na, r, radix);
+		else
+			multiplies_limbs_schoolbook(a, na, b, nb, r, radix);
+		return;
+	}
+
+	if (nb >= ntt_threshold()) {
+		const ntt_packing<R> packing;
+		if (packing.coefficients(na) + packing.coefficients(nb) <= NTT_MAX_LENGTH) {
+			ntt_limbs(a, na, b, nb, r, radix);
+			return;
+		}
+	}
+
+	// Unbalanced, multiply b by nb sized pieces of a
+	if (2 * nb <= na) {
+		std::fill(r, r + na + nb, 0);
+		workspace::frame frame(w);
+		T* const piece = w.allocate<T>(2 * nb);
+		for (std::size_t i = 0; i < na; i += nb) {
+			std::size_t length = std::min(nb, na - i);
+			multiplies_limbs(a + i, length, b, nb, piece, radix, w);
+			plus_limbs(r + i, na + nb - i, piece, significant_limbs(piece, length + nb), r + i, radix);
+		}
+		return;
+	}
+
+	if (nb >= toom3_threshold() && nb > 2 * ((na + 2) / 3))
+		toom3_limbs(a, na, b, nb, r, radix, w);
+	else
+		karatsuba_limbs(a, na, b, nb, r, radix, w);
+}
+
+/**
+ * @return the number of base 10^9 limbs n decimal digits pack into
+ */
+inline std::size_t decimal9_limbs(std::size_t n) {
+	return (n + 8) / 9;
+}
+
+/**
+ * Packs the little endian decimal digits [a, a + n) into base 10^9 limbs
+ * [packed, packed + decimal9_limbs(n))
+ */
+template<typename T>
+void pack_decimal9(const T* a, std::size_t n, unsigned* packed) {
+	const std::size_t DIGITS = 9;
+
+	std::fill(packed, packed + decimal9_limbs(n), 0);
+	for (std::size_t i = n; i-- > 0;)
+		packed[i / DIGITS] = packed[i / DIGITS] * 10 + a[i];
+}
+
+/**
+ * Writes the low n decimal digits of the base 10^9 limbs into [a, a + n),
+ * consuming the limbs
+ */
+template<typename T>
+void unpack_decimal9(unsigned* packed, T* a, std::size_t n) {
+	const std::size_t DIGITS = 9;
+
+	for (std::size_t i = 0; i < n; ++i) {
+		a[i] = packed[i / DIGITS] % 10;
+		packed[i / DIGITS] /= 10;
+	}
+}
+
+/**
+ * [a, a + na) * [b, b + nb) => [r, r + na + nb) for decimal digits
+ * Packs nine digits into each base 10^9 limb so every tier above works on
+ * words instead of single digits
+ */
+template<typename T>
+void multiplies_limbs(const T* a, std::size_t na, const T* b, std::size_t nb, T* r, decimal_radix, workspace& w) {
+	workspace::frame frame(w);
+	const std::size_t packedNa = decimal9_limbs(na);
+	const std::size_t packedNb = decimal9_limbs(nb);
+	unsigned* const packedA = w.allocate<unsigned>(packedNa);
+	pack_decimal9(a, na, packedA);
+	unsigned* packedB = packedA;
+	if (a != b || na != nb) {
+		packedB = w.allocate<unsigned>(packedNb);
+		pack_decimal9(b, nb, packedB);
+	}
+
+	unsigned* const product = w.allocate<unsigned>(packedNa + packedNb);
+	multiplies_limbs(packedA, packedNa, packedB, packedNb, product, decimal9_radix(), w);
+	unpack_decimal9(product, r, na + nb);
+}
+
+/**
+ * [a, a + n) * [a, a + n) => [r, r + 2n)
+ */
+template<typename T, typename R>
+void square_limbs(const T* a, std::size_t n, T* r, R radix, workspace& w) {
+	multiplies_limbs(a, n, a, n, r, radix, w);
+}
+
+/**
+ * @return whether [b1, e1) and [b2, e2) are the same digits in memory
+ */
+template<typename I1, typename I2>
+bool same_digits(I1, I1, I2, I2) {
+	return false;
+}
+
+template<typename I>
+bool same_digits(I b1, I e1, I b2, I e2) {
+	return b1 == b2 && e1 == e2;
+}
+
+// random access iterators
+// O(n^1.585) once both operands reach karatsuba_threshold()
+// The same range twice is squared, at any length
+template<typename RI1, typename RI2, typename OI, typename R>
+OI multiplies_digits(RI1 b1, RI1 e1, RI2 b2, RI2 e2, OI x, ranTag, ranTag, R r, workspace& w) {
+	typedef typename std::iterator_traits<OI>::value_type result_type;
+	typedef std::reverse_iterator<result_type*> result_list_iterator;
+
+	const bool square = same_digits(b1, e1, b2, e2);
+	const std::size_t len1 = e1 - b1;
+	const std::size_t len2 = e2 - b2;
+	if (!square && std::min(len1, len2) < karatsuba_threshold())
+		return multiplies_digits(b1, e1, b2, e2, x, biTag(), biTag(), r, w);
+
+	workspace::frame frame(w);
+	result_type* const a = w.allocate<result_type>(len1);
+	result_type* const result = w.allocate<result_type>(len1 + len2);
+	std::copy(b1, e1, result_list_iterator(a + len1));
+	if (square)
+		square_limbs(a, len1, result, r, w);
+	else {
+		result_type* const b = w.allocate<result_type>(len2);
+		std::copy(b2, e2, result_list_iterator(b + len2));
+		multiplies_limbs(a, len1, b, len2, result, r, w);
+	}
+
+	return print_list(result_list_iterator(result + len1 + len2), result_list_iterator(result), x);
+}
+
+/**
+ * @param b  an iterator to the beginning of an input  sequence (inclusive)
+ * @param e  an iterator to the end       of an input  sequence (exclusive)
+ * @param b2 an iterator to the beginning of an input  sequence (inclusive)
+ * @param e2 an iterator to the end       of an input  sequence (exclusive)
+ * @param x  an iterator to the beginning of an output sequence (inclusive)
+ * @param r  the radix policy of all three sequences
+ * @param w  the workspace to draw scratch from
+ * @return   an iterator to the end       of an output sequence (exclusive)
+ * output the product of the two input sequences into the output sequence
+ * ([b1, e1) * [b2, e2)) => x
+ */
+template<typename I1, typename I2, typename OI, typename R>
+OI multiplies_digits(I1 b1, I1 e1, I2 b2, I2 e2, OI x, R r, workspace& w) {
+	typedef typename std::iterator_traits<I1>::iterator_category iCat1;
+	typedef typename std::iterator_traits<I2>::iterator_category iCat2;
+
+	b1 = strip_zeroes(b1, e1);
+	b2 = strip_zeroes(b2, e2);
+	// Multiply by 0
+	if (b1 == e1 || b2 == e2) {
+		*x++ = 0;
+		return x;
+	}
+
+	// Multiply by 1
+	if (is_one(b1, e1))
+		return print_list(b2, e2, x);
+	if (is_one(b2, e2))
+		return print_list(b1, e1, x);
+
+	return multiplies_digits(b1, e1, b2, e2, x, iCat1(), iCat2(), r, w);
+}
+
+/**
+ * scratch comes from this thread's workspace
+ * ([b1, e1) * [b2, e2)) => x
+ */
+template<typename I1, typename I2, typename OI, typename R>
+OI multiplies_digits(I1 b1, I1 e1, I2 b2, I2 e2, OI x, R r) {
+	return multiplies_digits(b1, e1, b2, e2, x, r, default_workspace());
+}
+
+/**
+ * the sequences are of decimal digits
+ * ([b1, e1) * [b2, e2)) => x
+ */
+template<typename I1, typename I2, typename OI>
+OI multiplies_digits(I1 b1, I1 e1, I2 b2, I2 e2, OI x) {
+	return multiplies_digits(b1, e1, b2, e2, x, decimal_radix());
+}
+
+/**
+ * @param b an iterator to the beginning of an input  sequence (inclusive)
+ * @param e an iterator to the end       of an input  sequence (exclusive)
+ * @param x an iterator to the beginning of an output sequence (inclusive)
+ * @param r the radix policy of both sequences
+ * @param w the workspace to draw scratch from
+ * @return  an iterator to the end       of an output sequence (exclusive)
+ * output the square of the input sequence into the output sequence, with
+ * random access iterators each cross product is worked out once
+ * ([b, e) * [b, e)) => x
+ */
+template<typename FI, typename OI, typename R>
+OI square_digits(FI b, FI e, OI x, R r, workspace& w) {
+	return multiplies_digits(b, e, b, e, x, r, w);
+}
+
+/**
+ * scratch comes from this thread's workspace
+ * ([b, e) * [b, e)) => x
+ */
+template<typename FI, typename OI, typename R>
+OI square_digits(FI b, FI e, OI x, R r) {
+	return square_digits(b, e, x, r, default_workspace());
+}
+
+/**
+ * the sequences are of decimal digits
+ * ([b, e) * [b, e)) => x
+ */
+template<typename FI, typename OI>
+OI square_digits(FI b, FI e, OI x) {
+	return square_digits(b, e, x, decimal_radix());
+}
+
+// ------------
+// Lucas-Lehmer
+// ------------
+
+/**
+ * [x, x + nx) mod 2^p - 1 => [r, r + (p + 31) / 32) in binary32 limbs
+ * x < 2^2p, so folding the bits from p up onto the ones below, and then
+ * the one bit that can carry out of that, reduces it without dividing
+ * r may be x
+ */
+inline void mersenne_reduce_limbs(const unsigned* x, std::size_t nx, unsigned p, unsigned* r, workspace& w) {
+	const std::size_t n = (p + 31) / 32;
+	const std::size_t q = p / 32;
+	const unsigned bit = p % 32;
+	const unsigned topMask = bit != 0 ? (1u << bit) - 1 : ~0u;
+
+	workspace::frame frame(w);
+	unsigned* const high = w.allocate<unsigned>(n);
+	for (std::size_t i = 0; i < n && q + i < nx; ++i) {
+		high[i] = x[q + i] >> bit;
+		if (bit != 0 && q + i + 1 < nx)
+			high[i] |= x[q + i + 1] << (32 - bit);
+	}
+	for (std::size_t i = 0; i < n; ++i)
+		r[i] = i < nx ? x[i] : 0;
+	r[n - 1] &= topMask;
+
+	unsigned carry = plus_limbs(r, n, high, n, r, binary32_radix());
+	if (bit != 0) {
+		carry = r[n - 1] >> bit;
+		r[n - 1] &= topMask;
+	}
+	const unsigned ONE[] = {1};
+	if (carry != 0)
+		plus_limbs(r, n, ONE, 1, r, binary32_radix());
+
+	// 2^p - 1 itself is 0
+	if (r[n - 1] == topMask && std::count(r, r + n - 1, ~0u) == static_cast<std::ptrdiff_t>(n - 1))
+		std::fill(r, r + n, 0);
+}
+
+/**
+ * @param p the exponent
+ * @param w the workspace to draw scratch from
+ * @return  whether 2^p - 1 is prime
+ * Lucas-Lehmer: with s = 4, 2^p - 1 is prime when p - 2 rounds of
+ * s = s^2 - 2 mod 2^p - 1 leave 0, every round a square and a fold
+ */
+inline bool lucas_lehmer(unsigned p, workspace& w) {
+	// 2^ab - 1 is divisible by 2^a - 1, and the test needs p odd
+	if (p < 2)
+		return false;
+	if (p == 2)
+		return true;
+	for (unsigned d = 2; d * d <= p; ++d) {
+		if (p % d == 0)
+			return false;
+	}
+
+	const std::size_t n = (p + 31) / 32;
+	const unsigned topMask = p % 32 != 0 ? (1u << p % 32) - 1 : ~0u;
+	workspace::frame frame(w);
+	unsigned* const s = w.allocate<unsigned>(n);
+	unsigned* const square = w.allocate<unsigned>(2 * n);
+	s[0] = 4;
+	for (unsigned i = 2; i < p; ++i) {
+		const std::size_t length = significant_limbs(s, n);
+		square_limbs(s, length, square, binary32_radix(), w);
+		std::fill(square + 2 * length, square + 2 * n, 0);
+		mersenne_reduce_limbs(square, 2 * n, p, s, w);
+
+		// Below 2 the subtraction wraps around to 2^p - 1 - (2 - s)
+		if (significant_limbs(s, n) <= 1 && s[0] < 2) {
+			const unsigned wrap = 2 - s[0];
+			std::fill(s, s + n, ~0u);
+			s[n - 1] = topMask;
+			s[0] -= wrap;
+		}
+		else {
+			const unsigned TWO[] = {2};
+			minus_limbs(s, n, TWO, 1, s, binary32_radix());
+		}
+	}
+	return significant_limbs(s, n) == 0;
+}
+
+/**
+ * scratch comes from this thread's workspace
+ */
+inline bool lucas_lehmer(unsigned p) {
+	return lucas_lehmer(p, default_workspace());
+}
+
+// Divides
+/**
+ * [u, u + nu) / [v, v + nv) => [q, q + nu - nv + 1)
+ * [u, u + nu) % [v, v + nv) => [r, r + nv)
+ * Little endian, nu >= nv and v[nv - 1] != 0
+ * Knuth's Algorithm D: normalize, estimate each quotient digit from the
+ * leading digits, multiply and subtract once, and add back in the rare
+ * case the estimate was one too large
+ * O(nv * (nu - nv))
+ */
+template<typename T, typename R>
+void divides_limbs_schoolbook(const T* u, std::size_t nu, const T* v, std::size_t nv, T* q, T* r, R, workspace& w) {
+	typedef typename R::wide_type wide_type;
+	typedef typename R::signed_wide_type signed_wide_type;
+	const wide_type B = R::base();
+	assert(nu >= nv && nv > 0 && v[nv - 1] != 0);
+
+	// Single digit divisors need no estimate
+	if (nv == 1) {
+		wide_type remainder = 0;
+		for (std::size_t i = nu; i-- > 0;) {
+			remainder = remainder * B + u[i];
+			q[i] = remainder / v[0];
+			remainder %= v[0];
+		}
+		r[0] = remainder;
+		return;
+	}
+
+	// Scale both so the top digit of the divisor is at least B / 2,
+	// which keeps every estimate at most two too large
+	const wide_type d = B / (static_cast<wide_type>(v[nv - 1]) + 1);
+	workspace::frame frame(w);
+	T* const un = w.allocate<T>(nu + 1);
+	T* const vn = w.allocate<T>(nv);
+	wide_type carry = 0;
+	for (std::size_t i = 0; i < nv; ++i) {
+		carry += static_cast<wide_type>(v[i]) * d;
+		vn[i] = carry % B;
+		carry /= B;
+	}
+	assert(carry == 0);
+	for (std::size_t i = 0; i < nu; ++i) {
+		carry += static_cast<wide_type>(u[i]) * d;
+		un[i] = carry % B;
+		carry /= B;
+	}
+	un[nu] = carry;
+
+	for (std::size_t j = nu - nv + 1; j-- > 0;) {
+		const wide_type top = static_cast<wide_type>(un[j + nv]) * B + un[j + nv - 1];
+		wide_type qhat = top / vn[nv - 1];
+		wide_type rhat = top % vn[nv - 1];
+		while (qhat >= B || qhat * vn[nv - 2] > rhat * B + un[j + nv - 2]) {
+			--qhat;
+			rhat += vn[nv - 1];
+			if (rhat >= B)
+				break;
+		}
+
+		// un[j, j + nv] -= qhat * vn
+		wide_type product = 0;
+		signed_wide_type difference = 0;
+		for (std::size_t i = 0; i < nv; ++i) {
+			product += qhat * vn[i];
+			difference += static_cast<signed_wide_type>(un[i + j]) - static_cast<signed_wide_type>(product % B);
+			product /= B;
+			if (difference < 0) {
+				un[i + j] = difference + B;
+				difference = -1;
+			}
+			else {
+				un[i + j] = difference;
+				difference = 0;
+			}
+		}
+		difference += static_cast<signed_wide_type>(un[j + nv]) - static_cast<signed_wide_type>(product);
+
+		// The estimate was one too large, add the divisor back
+		if (difference < 0) {
+			--qhat;
+			carry = 0;
+			for (std::size_t i = 0; i < nv; ++i) {
+				carry += static_cast<wide_type>(un[i + j]) + vn[i];
+				un[i + j] = carry % B;
+				carry /= B;
+			}
+			difference += carry;
+		}
+		assert(difference >= 0);
+		un[j + nv] = difference;
+		q[j] = qhat;
+	}
+
+	// Undo the scaling on the remainder
+	wide_type remainder = 0;
+	for (std::size_t i = nv; i-- > 0;) {
+		remainder = remainder * B + un[i];
+		r[i] = remainder / d;
+		remainder %= d;
+	}
+}
+
+/**
+ * Divisors and quotients with fewer digits than this use Algorithm D alone
+ * Returned by reference so it can be tuned per machine
+ */
+inline std::size_t& burnikel_ziegler_threshold() {
+	static std::size_t threshold = 60;
+	return threshold;
+}
+
+template<typename T, typename R>
+void divides_3n2n_limbs(const T* a, const T* b, std::size_t n, T* q, T* r, R radix, workspace& w);
+
+/**
+ * [a, a + 2n) / [b, b + n) => [q, q + n)
+ * [a, a + 2n) % [b, b + n) => [r, r + n)
+ * Little endian, b normalized and [a + n, a + 2n) < [b, b + n)
+ * Divides the top three halves of a by b, then the remainder and the
+ * last half, so each step is half the size of the one above
+ * O(M(n) log n)
+ */
+template<typename T, typename R>
+void divides_2n1n_limbs(const T* a, const T* b, std::size_t n, T* q, T* r, R radix, workspace& w) {
+	workspace::frame frame(w);
+	if (n < burnikel_ziegler_threshold()) {
+		T* const quotient = w.allocate<T>(n + 1);
+		divides_limbs_schoolbook(a, 2 * n, b, n, quotient, r, radix, w);
+		assert(quotient[n] == 0);
+		std::copy(quotient, quotient + n, q);
+		return;
+	}
+
+	assert(n % 2 == 0);
+	const std::size_t h = n / 2;
+	T* const next = w.allocate<T>(3 * h);
+	divides_3n2n_limbs(a + h, b, h, q + h, next + h, radix, w);
+	std::copy(a, a + h, next);
+	divides_3n2n_limbs(next, b, h, q, r, radix, w);
+}
+
+/**
+ * [a, a + 3n) / [b, b + 2n) => [q, q + n)
+ * [a, a + 3n) % [b, b + 2n) => [r, r + 2n)
+ * Little endian, b normalized and [a + n, a + 3n) < [b, b + 2n)
+ * Estimates the quotient from the top halves, then corrects it at most
+ * twice against the low half of b
+ */
+template<typename T, typename R>
+void divides_3n2n_limbs(const T* a, const T* b, std::size_t n, T* q, T* r, R radix, workspace& w) {
+	// [a + n, a + 3n) / [b + n, b + 2n), remainder in the top of partial
+	workspace::frame frame(w);
+	const std::size_t nPartial = 2 * n + 2;
+	T* const partial = w.allocate<T>(nPartial);
+	std::copy(a, a + n, partial);
+	if (compare_limbs(a + 2 * n, n, b + n, n) == 0) {
+		// The estimate would be B^n, so it is clamped to B^n - 1
+		std::fill(q, q + n, R::base() - 1);
+		partial[2 * n] = plus_limbs(a + n, n, b + n, n, partial + n, radix);
+	}
+	else
+		divides_2n1n_limbs(a + n, b + n, n, q, partial + n, radix, w);
+
+	// partial - q * [b, b + n), adding b back while it would go negative
+	T* const product = w.allocate<T>(2 * n);
+	multiplies_limbs(q, n, b, n, product, radix, w);
+	const T ONE[] = {1};
+	while (compare_limbs(partial, nPartial, product, 2 * n) < 0) {
+		T carry = plus_limbs(partial, nPartial, b, 2 * n, partial, radix);
+		assert(carry == 0);
+		(void) carry;
+		minus_limbs(q, n, ONE, 1, q, radix);
+	}
+	minus_limbs(partial, nPartial, product, 2 * n, partial, radix);
+	assert(significant_limbs(partial, nPartial) <= 2 * n);
+	std::copy(partial, partial + 2 * n, r);
+}
+
+/**
+ * [u, u + nu) / [v, v + nv) => [q, q + nu - nv + 1)
+ * [u, u + nu) % [v, v + nv) => [r, r + nv)
+ * Little endian, nu >= nv and v[nv - 1] != 0
+ * Long divisors with long quotients go through Burnikel and Ziegler's
+ * recursion, which cuts the dividend into nv digit blocks and divides two
+ * blocks at a time, so the work rides on multiplies_limbs
+ */
+template<typename T, typename R>
+void divides_limbs(const T* u, std::size_t nu, const T* v, std::size_t nv, T* q, T* r, R radix, workspace& w) {
+	typedef typename R::wide_type wide_type;
+	const wide_type B = R::base();
+	assert(nu >= nv && nv > 0 && v[nv - 1] != 0);
+
+	if (nv < burnikel_ziegler_threshold() || nu - nv < burnikel_ziegler_threshold()) {
+		divides_limbs_schoolbook(u, nu, v, nv, q, r, radix, w);
+		return;
+	}
+
+	// The block length is j * 2^k with j below the threshold, so every
+	// level of the recursion halves evenly; both operands move up by the
+	// shift digits it adds to the divisor, which leaves the quotient alone
+	std::size_t n = nv;
+	std::size_t k = 0;
+	while (n >= burnikel_ziegler_threshold()) {
+		n = (n + 1) / 2;
+		++k;
+	}
+	n <<= k;
+	const std::size_t shift = n - nv;
+
+	// Scale both the same way Algorithm D does; the dividend is padded to
+	// whole blocks with a zero digit on top, so its top block is below vn
+	const wide_type d = B / (static_cast<wide_type>(v[nv - 1]) + 1);
+	const std::size_t blocks = (shift + nu + 1) / n + 1;
+	workspace::frame frame(w);
+	T* const un = w.allocate<T>(blocks * n);
+	T* const vn = w.allocate<T>(n);
+	wide_type carry = 0;
+	for (std::size_t i = 0; i < nv; ++i) {
+		carry += static_cast<wide_type>(v[i]) * d;
+		vn[shift + i] = carry % B;
+		carry /= B;
+	}
+	assert(carry == 0);
+	for (std::size_t i = 0; i < nu; ++i) {
+		carry += static_cast<wide_type>(u[i]) * d;
+		un[shift + i] = carry % B;
+		carry /= B;
+	}
+	un[shift + nu] = carry;
+
+	T* const quotient = w.allocate<T>((blocks - 1) * n);
+	T* const pair = w.allocate<T>(2 * n);
+	std::copy(un + (blocks - 1) * n, un + blocks * n, pair + n);
+	for (std::size_t i = blocks - 1; i-- > 0;) {
+		std::copy(un + i * n, un + (i + 1) * n, pair);
+		divides_2n1n_limbs(pair, vn, n, quotient + i * n, pair + n, radix, w);
+	}
+	assert(significant_limbs(quotient, (blocks - 1) * n) <= nu - nv + 1);
+	std::copy(quotient, quotient + (nu - nv + 1), q);
+
+	// Undo the shift and the scaling on the remainder
+	assert(significant_limbs(pair + n, shift) == 0);
+	wide_type remainder = 0;
+	for (std::size_t i = nv; i-- > 0;) {
+		remainder = remainder * B + pair[n + shift + i];
+		r[i] = remainder / d;
+		remainder %= d;
+	}
+}
+
+/**
+ * Decimal digits are divided nine at a time, packed into base 10^9 limbs
+ */
+template<typename T>
+void divides_limbs(const T* u, std::size_t nu, const T* v, std::size_t nv, T* q, T* r, decimal_radix, workspace& w) {
+	workspace::frame frame(w);
+	const std::size_t packedNu = decimal9_limbs(nu);
+	const std::size_t packedNv = decimal9_limbs(nv);
+	unsigned* const packedU = w.allocate<unsigned>(packedNu);
+	unsigned* const packedV = w.allocate<unsigned>(packedNv);
+	pack_decimal9(u, nu, packedU);
+	pack_decimal9(v, nv, packedV);
+
+	unsigned* const packedQ = w.allocate<unsigned>(packedNu - packedNv + 1);
+	unsigned* const packedR = w.allocate<unsigned>(packedNv);
+	divides_limbs(packedU, packedNu, packedV, packedNv, packedQ, packedR, decimal9_radix(), w);
+
+	unpack_decimal9(packedQ, q, nu - nv + 1);
+	unpack_decimal9(packedR, r, nv);
+}
+
+/**
+ * An output iterator that drops everything written to it, for the results
+ * a caller doesn't want
+ */
+struct discard_iterator {
+	typedef std::output_iterator_tag iterator_category;
+	typedef void value_type;
+	typedef void difference_type;
+	typedef void pointer;
+	typedef void reference;
+
+	template<typename T>
+	discard_iterator& operator=(const T&) {
+		return *this;
+	}
+
+	discard_iterator& operator*() {
+		return *this;
+	}
+
+	discard_iterator& operator++() {
+		return *this;
+	}
+
+	discard_iterator operator++(int) {
+		return *this;
+	}
+};
+
+/**
+ * Writes decimal digits into [p, last) as characters, counting the ones
+ * that do not fit instead of writing past last
+ */
+struct char_digit_iterator {
+	typedef std::output_iterator_tag iterator_category;
+	typedef void value_type;
+	typedef void difference_type;
+	typedef void pointer;
+	typedef void reference;
+
+	char* p;
+	char* last;
+	std::size_t overflow;
+
+	char_digit_iterator(char* first, char* l) :
+			p(first),
+			last(l),
+			overflow(0) {
+	}
+
+	template<typename T>
+	char_digit_iterator& operator=(const T& digit) {
+		if (p == last)
+			++overflow;
+		else
+			*p++ = static_cast<char>('0' + digit);
+		return *this;
+	}
+
+	char_digit_iterator& operator*() {
+		return *this;
+	}
+
+	char_digit_iterator& operator++() {
+		return *this;
+	}
+
+	// The position lives in the iterator, so *x++ has to write through
+	// this one rather than a copy
+	char_digit_iterator& operator++(int) {
+		return *this;
+	}
+};
+
+/**
+ * Copies the big endian digits [b, e) into the workspace little endian,
+ * without leading zeroes
+ * @return the number of digits copied
+ */
+template<typename T, typename FI>
+std::size_t copy_limbs(FI b, FI e, T*& a, workspace& w, std::forward_iterator_tag) {
+	b = strip_zeroes(b, e);
+	const std::size_t n = std::distance(b, e);
+	a = w.allocate<T>(n);
+	std::copy(b, e, std::reverse_iterator<T*>(a + n));
+	return n;
+}
+
+// Input iterators can only be read once, so they are counted in a copy
+template<typename T, typename II>
+std::size_t copy_limbs(II b, II e, T*& a, workspace& w, std::input_iterator_tag) {
+	const std::vector<T> digits(b, e);
+	return copy_limbs(digits.begin(), digits.end(), a, w, std::forward_iterator_tag());
+}
+
+/**
+ * @param b  an iterator to the beginning of an input  sequence (inclusive)
+ * @param e  an iterator to the end       of an input  sequence (exclusive)
+ * @param b2 an iterator to the beginning of an input  sequence (inclusive)
+ * @param e2 an iterator to the end       of an input  sequence (exclusive)
+ * @param x  an iterator to the beginning of the quotient  sequence (inclusive)
+ * @param y  an iterator to the beginning of the remainder sequence (inclusive)
+ * @param r  the radix policy of all four sequences
+ * @param w  the workspace to draw scratch from
+ * @return   iterators to the ends of the quotient and remainder sequences (exclusive)
+ * output the quotient and the remainder of the two input sequences
+ * ([b1, e1) / [b2, e2)) => x
+ * ([b1, e1) % [b2, e2)) => y
+ * Reads each input once, so input iterators are enough
+ */
+template<typename II1, typename II2, typename OI1, typename OI2, typename R>
+std::pair<OI1, OI2> divides_digits(II1 b1, II1 e1, II2 b2, II2 e2, OI1 x, OI2 y, R r, workspace& w) {
+	typedef typename std::iterator_traits<OI1>::value_type result_type;
+	typedef std::reverse_iterator<result_type*> result_list_iterator;
+	typedef typename std::iterator_traits<II1>::iterator_category iCat1;
+	typedef typename std::iterator_traits<II2>::iterator_category iCat2;
+
+	// Little endian copies without leading zeroes
+	workspace::frame frame(w);
+	result_type* u;
+	result_type* v;
+	const std::size_t nu = copy_limbs(b1, e1, u, w, iCat1());
+	const std::size_t nv = copy_limbs(b2, e2, v, w, iCat2());
+	assert(nv > 0 && "can't divide by zero");
+
+	// Dividend smaller than the divisor
+	if (nu < nv) {
+		*x++ = 0;
+		y = print_list(result_list_iterator(u + nu), result_list_iterator(u), y);
+		return std::make_pair(x, y);
+	}
+
+	result_type* const quotient = w.allocate<result_type>(nu - nv + 1);
+	result_type* const remainder = w.allocate<result_type>(nv);
+	divides_limbs(u, nu, v, nv, quotient, remainder, r, w);
+
+	x = print_list(result_list_iterator(quotient + (nu - nv + 1)), result_list_iterator(quotient), x);
+	y = print_list(result_list_iterator(remainder + nv), result_list_iterator(remainder), y);
+	return std::make_pair(x, y);
+}
+
+/**
+ * scratch comes from this thread's workspace
+ * ([b1, e1) / [b2, e2)) => x
+ * ([b1, e1) % [b2, e2)) => y
+ */
+template<typename II1, typename II2, typename OI1, typename OI2, typename R>
+std::pair<OI1, OI2> divides_digits(II1 b1, II1 e1, II2 b2, II2 e2, OI1 x, OI2 y, R r) {
+	return divides_digits(b1, e1, b2, e2, x, y, r, default_workspace());
+}
+
+/**
+ * @param b  an iterator to the beginning of an input  sequence (inclusive)
+ * @param e  an iterator to the end       of an input  sequence (exclusive)
+ * @param b2 an iterator to the beginning of an input  sequence (inclusive)
+ * @param e2 an iterator to the end       of an input  sequence (exclusive)
+ * @param x  an iterator to the beginning of an output sequence (inclusive)
+ * @param r  the radix policy of all three sequences
+ * @param w  the workspace to draw scratch from
+ * @return   an iterator to the end       of an output sequence (exclusive)
+ * output the division of the two input sequences into the output sequence
+ * ([b1, e1) / [b2, e2)) => x
+ */
+template<typename II1, typename II2, typename OI, typename R>
+OI divides_digits(II1 b1, II1 e1, II2 b2, II2 e2, OI x, R r, workspace& w) {
+	return divides_digits(b1, e1, b2, e2, x, discard_iterator(), r, w).first;
+}
+
+/**
+ * scratch comes from this thread's workspace
+ * ([b1, e1) / [b2, e2)) => x
+ */
+template<typename II1, typename II2, typename OI, typename R>
+OI divides_digits(II1 b1, II1 e1, II2 b2, II2 e2, OI x, R r) {
+	return divides_digits(b1, e1, b2, e2, x, r, default_workspace());
+}
+
+/**
+ * the sequences are of decimal digits
+ * ([b1, e1) / [b2, e2)) => x
+ */
+template<typename II1, typename II2, typename OI>
+OI divides_digits(II1 b1, II1 e1, II2 b2, II2 e2, OI x) {
+	return divides_digits(b1, e1, b2, e2, x, decimal_radix());
+}
+
+// Radix conversion
+/**
+ * [a, a + n) => [x, x + 2^(k + 1)), little endian base 10^9 chunks padded
+ * with zeroes, a < powers[k]^2 and powers[k] = 10^(9 * 2^k)
+ * Divides by powers[k] and converts the quotient and remainder separately,
+ * so the work rides on divides_limbs
+ * O(M(n) log n)
+ */
+template<typename T, typename R>
+void radix_to_decimal9_limbs(const T* a, std::size_t n, const std::vector< std::vector<T> >& powers, std::size_t k, unsigned* x, R radix) {
+	typedef typename R::wide_type wide_type;
+	typedef std::vector<T> limb_list;
+	const wide_type CHUNK = 1000000000;
+	const std::size_t count = static_cast<std::size_t>(2) << k;
+
+	// Short numbers repeatedly divide by 10^9
+	n = significant_limbs(a, n);
+	if (k == 0 || n < karatsuba_threshold()) {
+		limb_list limbs(a, a + n);
+		std::fill(x, x + count, 0);
+		for (std::size_t i = 0; n > 0; ++i) {
+			assert(i < count);
+			wide_type remainder = 0;
+			for (std::size_t j = n; j-- > 0;) {
+				const wide_type current = remainder * R::base() + limbs[j];
+				limbs[j] = current / CHUNK;
+				remainder = current % CHUNK;
+			}
+			x[i] = remainder;
+			n = significant_limbs(&limbs[0], n);
+		}
+		return;
+	}
+
+	const limb_list& power = powers[k];
+	if (n < power.size()) {
+		radix_to_decimal9_limbs(a, n, powers, k - 1, x, radix);
+		std::fill(x + count / 2, x + count, 0);
+		return;
+	}
+	limb_list quotient(n - power.size() + 1);
+	limb_list remainder(power.size());
+	divides_limbs(a, n, &power[0], power.size(), &quotient[0], &remainder[0], radix, default_workspace());
+	radix_to_decimal9_limbs(&remainder[0], remainder.size(), powers, k - 1, x, radix);
+	radix_to_decimal9_limbs(&quotient[0], quotient.size(), powers, k - 1, x + count / 2, radix);
+}
+
+/**
+ * @param b  an iterator to the beginning of an input  sequence (inclusive)
+ * @param e  an iterator to the end       of an input  sequence (exclusive)
+ * @param x  an iterator to the beginning of an output sequence (inclusive)
+ * @param r  the radix policy of the input sequence
+ * @return   an iterator to the end       of an output sequence (exclusive)
+ * output the decimal digits of the input sequence into the output sequence
+ * Squares 10^9 up to half the length of the input once, then splits the
+ * input by those powers down to short pieces
+ * O(M(n) log n)
+ */
+template<typename II, typename OI, typename R>
+OI radix_to_decimal(II b, II e, OI x, R r) {
+	typedef typename std::iterator_traits<II>::value_type limb_type;
+	typedef std::vector<limb_type> limb_list;
+	typedef typename R::wide_type wide_type;
+	const int CHUNK_DIGITS = 9;
+
+	// Little endian copy without leading zeroes
+	limb_list limbs(b, e);
+	std::reverse(limbs.begin(), limbs.end());
+	while (!limbs.empty() && limbs.back() == 0)
+		limbs.pop_back();
+	if (limbs.empty()) {
+		*x++ = 0;
+		return x;
+	}
+	const std::size_t n = limbs.size();
+
+	// powers[k] = 10^(9 * 2^k), up to one whose square is longer than the input
+	std::vector<limb_list> powers(1);
+	for (wide_type chunk = 1000000000; chunk != 0; chunk /= R::base())
+		powers[0].push_back(chunk % R::base());
+	while (n + 2 > 2 * powers.back().size()) {
+		const limb_list& last = powers.back();
+		limb_list square(2 * last.size());
+		multiplies_limbs(&last[0], last.size(), &last[0], last.size(), &square[0], r, default_workspace());
+		square.resize(significant_limbs(&square[0], square.size()));
+		powers.push_back(square);
+	}
+
+	const std::size_t k = powers.size() - 1;
+	std::vector<unsigned> chunks(static_cast<std::size_t>(2) << k);
+	radix_to_decimal9_limbs(&limbs[0], n, powers, k, &chunks[0], r);
+	chunks.resize(significant_limbs(&chunks[0], chunks.size()));
+
+	// Leading chunk without its zeroes, the rest padded to nine digits
+	int digits[CHUNK_DIGITS];
+	for (std::vector<unsigned>::reverse_iterator i = chunks.rbegin(); i != chunks.rend(); ++i) {
+		unsigned chunk = *i;
+		for (int j = CHUNK_DIGITS - 1; j >= 0; --j) {
+			digits[j] = static_cast<int>(chunk % 10);
+			chunk /= 10;
+		}
+		if (i == chunks.rbegin())
+			x = print_list(digits, digits + CHUNK_DIGITS, x);
+		else
+			x = std::copy(digits, digits + CHUNK_DIGITS, x);
+	}
+	return x;
+}
+
+// Already decimal
+template<typename II, typename OI>
+OI radix_to_decimal(II b, II e, OI x, decimal_radix) {
+	return print_list(b, e, x);
+}
+
+/**
+ * @return the most decimal digits one limb in radix R can take, the length
+ * of base - 1
+ */
+template<typename R>
+std::size_t decimal_digits_per_limb(R) {
+	std::size_t digits = 0;
+	for (typename R::wide_type limb = R::base() - 1; limb != 0; limb /= 10)
+		++digits;
+	return digits;
+}
+
+/**
+ * [a, a + n) little endian base 10^9 chunks => little endian limbs in radix r
+ * without leading zeroes, powers[k] = 10^(9 * 2^k) up to the k with
+ * 2^k < n <= 2^(k + 1)
+ * Converts the low 2^k chunks and the rest separately and joins them as
+ * high * powers[k] + low
+ * O(M(n) log n)
+ */
+template<typename T, typename R>
+std::vector<T> decimal9_to_radix_limbs(const unsigned* a, std::size_t n, const std::vector< std::vector<T> >& powers, R radix) {
+	typedef typename R::wide_type wide_type;
+	typedef std::vector<T> limb_list;
+	const wide_type CHUNK = 1000000000;
+
+	// Short inputs multiply in one chunk at a time
+	if (n < karatsuba_threshold()) {
+		limb_list limbs;
+		for (std::size_t i = n; i-- > 0;) {
+			wide_type carry = a[i];
+			for (std::size_t j = 0; j < limbs.size(); ++j) {
+				carry += static_cast<wide_type>(limbs[j]) * CHUNK;
+				limbs[j] = carry % R::base();
+				carry /= R::base();
+			}
+			while (carry != 0) {
+				limbs.push_back(carry % R::base());
+				carry /= R::base();
+			}
+		}
+		return limbs;
+	}
+
+	std::size_t k = 0;
+	while ((static_cast<std::size_t>(2) << k) < n)
+		++k;
+	const std::size_t half = static_cast<std::size_t>(1) << k;
+	const limb_list low = decimal9_to_radix_limbs(a, half, powers, radix);
+	const limb_list high = decimal9_to_radix_limbs(a + half, n - half, powers, radix);
+	if (high.empty())
+		return low;
+
+	const limb_list& power = powers[k];
+	limb_list result(high.size() + power.size());
+	multiplies_limbs(&high[0], high.size(), &power[0], power.size(), &result[0], radix, default_workspace());
+	if (!low.empty()) {
+		T carry = plus_limbs(&result[0], result.size(), &low[0], low.size(), &result[0], radix);
+		assert(carry == 0);
+		(void) carry;
+	}
+	result.resize(significant_limbs(&result[0], result.size()));
+	return result;
+}
+
+/**
+ * [a, a + n) little endian base 10^9 chunks => x, most significant first
+ * Squares 10^9 once per level of decimal9_to_radix_limbs
+ */
+template<typename T, typename OI, typename R>
+OI decimal9_to_radix(const std::vector<unsigned>& chunks, OI x, R r) {
+	typedef std::vector<T> limb_list;
+	typedef typename R::wide_type wide_type;
+
+	// powers[k] = 10^(9 * 2^k), up to half the number of chunks
+	std::vector<limb_list> powers(1);
+	for (wide_type chunk = 1000000000; chunk != 0; chunk /= R::base())
+		powers[0].push_back(chunk % R::base());
+	while ((static_cast<std::size_t>(1) << powers.size()) < chunks.size()) {
+		const limb_list& last = powers.back();
+		limb_list square(2 * last.size());
+		multiplies_limbs(&last[0], last.size(), &last[0], last.size(), &square[0], r, default_workspace());
+		square.resize(significant_limbs(&square[0], square.size()));
+		powers.push_back(square);
+	}
+
+	const limb_list limbs = decimal9_to_radix_limbs(&chunks[0], chunks.size(), powers, r);
+	if (limbs.empty()) {
+		*x++ = 0;
+		return x;
+	}
+	return print_list(limbs.rbegin(), limbs.rend(), x);
+}
+
+/**
+ * @param b  an iterator to the beginning of an input  sequence (inclusive)
+ * @param e  an iterator to the end       of an input  sequence (exclusive)
+ * @param x  an iterator to the beginning of an output sequence (inclusive)
+ * @param r  the radix policy of the output sequence
+ * @return   an iterator to the end       of an output sequence (exclusive)
+ * output the decimal digits of the input sequence as digits in radix r
+ * Packs nine decimal digits per chunk, then joins the chunks by halves
+ * O(M(n) log n)
+ */
+template<typename II, typename OI, typename R>
+OI decimal_to_radix(II b, II e, OI x, R r) {
+	typedef typename R::wide_type wide_type;
+	const std::size_t CHUNK_DIGITS = 9;
+
+	// Least significant chunk first, the last one takes the leftover digits
+	const std::vector<int> digits(b, e);
+	std::vector<unsigned> chunks((digits.size() + CHUNK_DIGITS - 1) / CHUNK_DIGITS);
+	for (std::size_t i = 0; i < digits.size(); ++i) {
+		unsigned& chunk = chunks[(digits.size() - 1 - i) / CHUNK_DIGITS];
+		chunk = chunk * 10 + digits[i];
+	}
+	return decimal9_to_radix<wide_type>(chunks, x, r);
+}
+
+// Already decimal
+template<typename II, typename OI>
+OI decimal_to_radix(II b, II e, OI x, decimal_radix) {
+	return print_list(b, e, x);
+}
+
+// ------------------
+// Barrett reduction
+// ------------------
+
+/**
+ * Residues mod [m, m + n) reduced by Barrett's method: with the reciprocal
+ * mu = B^2n / m worked out once, the quotient of anything below B^2n is
+ * estimated from its top limbs times mu to within 2, so a reduction is two
+ * products and at most two subtractions of m instead of a long division
+ * Every residue is n little endian limbs, below m
+ */
+template<typename T, typename R>
+class barrett_form {
+	private:
+		const T* m;
+		std::size_t n;
+		const T* mu;
+
+		/**
+		 * [x, x + 2n) => [r, r + n)
+		 */
+		void reduce_wide(const T* x, T* r, workspace& w) const {
+			workspace::frame frame(w);
+
+			// q = (x / B^(n - 1)) * mu / B^(n + 1)
+			T* const estimate = w.allocate<T>(2 * n + 3);
+			const std::size_t nx = significant_limbs(x + n - 1, n + 1);
+			const std::size_t nmu = significant_limbs(mu, n + 2);
+			if (nx != 0)
+				multiplies_limbs(x + n - 1, nx, mu, nmu, estimate, R(), w);
+			const T* const q = estimate + n + 1;
+			const std::size_t nq = significant_limbs(q, n + 2);
+
+			// x - q * m, known to be below 3m, so mod B^(n + 1)
+			T* const product = w.allocate<T>(2 * n + 2);
+			if (nq != 0)
+				multiplies_limbs(q, nq, m, n, product, R(), w);
+			T* const remainder = w.allocate<T>(n + 1);
+			minus_limbs(x, n + 1, product, n + 1, remainder, R());
+			while (compare_limbs(remainder, n + 1, m, n) >= 0)
+				minus_limbs(remainder, n + 1, m, n, remainder, R());
+			std::copy(remainder, remainder + n, r);
+		}
+
+	public:
+		/**
+		 * B^2n / [m, m + n) => [mu, mu + n + 2), m[n - 1] != 0
+		 */
+		static void reciprocal(const T* m, std::size_t n, T* mu, workspace& w) {
+			workspace::frame frame(w);
+			T* const power = w.allocate<T>(2 * n + 1);
+			T* const remainder = w.allocate<T>(n);
+			power[2 * n] = 1;
+			divides_limbs(power, 2 * n + 1, m, n, mu, remainder, R(), w);
+		}
+
+		barrett_form(const T* modulus, std::size_t length, const T* reciprocal) :
+				m(modulus),
+				n(length),
+				mu(reciprocal) {
+		}
+
+		std::size_t length() const {
+			return n;
+		}
+
+		/**
+		 * [x, x + nx) mod m => [r, r + n)
+		 * Takes x n limbs at a time from the top, each with the remainder so
+		 * far above it, which keeps every step below m * B^n
+		 */
+		void reduce(const T* x, std::size_t nx, T* r, workspace& w) const {
+			workspace::frame frame(w);
+			T* const t = w.allocate<T>(2 * n);
+			std::fill(r, r + n, 0);
+			for (std::size_t top = nx; top > 0;) {
+				const std::size_t bottom = top > n ? top - n : 0;
+				std::fill(t, t + 2 * n, 0);
+				std::copy(x + bottom, x + top, t);
+				std::copy(r, r + n, t + (top - bottom));
+				reduce_wide(t, r, w);
+				top = bottom;
+			}
+		}
+
+		/**
+		 * x * y => r, r may be x or y, and x and y the same residue
+		 */
+		void multiply(const T* x, const T* y, T* r, workspace& w) const {
+			workspace::frame frame(w);
+			T* const t = w.allocate<T>(2 * n);
+			const std::size_t nx = significant_limbs(x, n);
+			const std::size_t ny = significant_limbs(y, n);
+			if (x == y && nx != 0)
+				square_limbs(x, nx, t, R(), w);
+			else if (nx != 0 && ny != 0)
+				multiplies_limbs(x, nx, y, ny, t, R(), w);
+			reduce_wide(t, r, w);
+		}
+
+		void enter(const T* x, std::size_t nx, T* r, workspace& w) const {
+			reduce(x, nx, r, w);
+		}
+
+		void leave(const T* x, T* r, workspace&) const {
+			std::copy(x, x + n, r);
+		}
+};
+
+// -----------------------
+// Modular exponentiation
+// -----------------------
+
+/**
+ * @return the big endian radix r digits [b, e) as little endian binary32
+ * limbs without leading zeroes, by way of decimal unless r is binary32
+ */
+template<typename FI, typename R>
+std::vector<unsigned> binary32_limbs(FI b, FI e, R r) {
+	std::vector<int> decimal;
+	radix_to_decimal(b, e, std::back_inserter(decimal), r);
+	std::vector<unsigned> limbs;
+	decimal_to_radix(decimal.begin(), decimal.end(), std::back_inserter(limbs), binary32_radix());
+	std::reverse(limbs.begin(), limbs.end());
+	limbs.resize(significant_limbs(&limbs[0], limbs.size()));
+	return limbs;
+}
+
+template<typename FI>
+std::vector<unsigned> binary32_limbs(FI b, FI e, binary32_radix) {
+	std::vector<unsigned> limbs(b, e);
+	std::reverse(limbs.begin(), limbs.end());
+	limbs.resize(limbs.empty() ? 0 : significant_limbs(&limbs[0], limbs.size()));
+	return limbs;
+}
+
+#ifdef __SIZEOF_INT128__
+// Each 64 bit limb is two 32 bit ones
+template<typename FI>
+std::vector<unsigned> binary32_limbs(FI b, FI e, binary64_radix) {
+	std::vector<unsigned> limbs;
+	while (b != e) {
+		const unsigned long long limb = *--e;
+		limbs.push_back(static_cast<unsigned>(limb));
+		limbs.push_back(static_cast<unsigned>(limb >> 32));
+	}
+	limbs.resize(limbs.empty() ? 0 : significant_limbs(&limbs[0], limbs.size()));
+	return limbs;
+}
+#endif
+
+/**
+ * @return -m0^-1 mod B, or 0 when m0 shares a factor with the base B
+ * Euclid on B and m0, keeping only the coefficients of m0, mod B
+ */
+template<typename T, typename R>
+T montgomery_inverse(T m0, R) {
+	typedef typename R::wide_type wide_type;
+	const wide_type B = R::base();
+
+	wide_type r0 = B;
+	wide_type r1 = m0;
+	wide_type t0 = 0;
+	wide_type t1 = 1;
+	while (r1 != 0) {
+		const wide_type q = r0 / r1;
+		const wide_type r2 = r0 - q * r1;
+		const wide_type t2 = (t0 + B - q * t1 % B) % B;
+		r0 = r1;
+		r1 = r2;
+		t0 = t1;
+		t1 = t2;
+	}
+	if (r0 != 1)
+		return 0;
+	return static_cast<T>((B - t0) % B);
+}
+
+/**
+ * Residues mod [m, m + n) held as x * B^n mod m, for an m prime to the
+ * base B, so a product is reduced by adding multiples of m that clear its
+ * low n limbs instead of by dividing
+ * Every residue is n little endian limbs, below m
+ */
+template<typename T, typename R>
+class montgomery_form {
+	private:
+		const T* m;
+		std::size_t n;
+		T inverse;
+
+	public:
+		montgomery_form(const T* modulus, std::size_t length, T minusInverse) :
+				m(modulus),
+				n(length),
+				inverse(minusInverse) {
+		}
+
+		std::size_t length() const {
+			return n;
+		}
+
+		/**
+		 * [t, t + 2n + 1) / B^n mod m => [r, r + n), t < m * B^n
+		 * Overwrites t
+		 */
+		void reduce(T* t, T* r) const {
+			typedef typename R::wide_type wide_type;
+
+			for (std::size_t i = 0; i < n; ++i) {
+				const T u = static_cast<wide_type>(t[i]) * inverse % R::base();
+				wide_type carry = 0;
+				for (std::size_t j = 0; j < n; ++j) {
+					carry += t[i + j] + static_cast<wide_type>(u) * m[j];
+					t[i + j] = carry % R::base();
+					carry /= R::base();
+				}
+				for (std::size_t j = i + n; carry != 0; ++j) {
+					carry += t[j];
+					t[j] = carry % R::base();
+					carry /= R::base();
+				}
+			}
+
+			// What is left is below 2m
+			if (t[2 * n] != 0 || compare_limbs(t + n, n, m, n) >= 0)
+				minus_limbs(t + n, n + 1, m, n, t + n, R());
+			std::copy(t + n, t + 2 * n, r);
+		}
+
+		/**
+		 * x * y => r, r may be x or y, and x and y the same residue
+		 */
+		void multiply(const T* x, const T* y, T* r, workspace& w) const {
+			workspace::frame frame(w);
+			T* const t = w.allocate<T>(2 * n + 1);
+			const std::size_t nx = significant_limbs(x, n);
+			const std::size_t ny = significant_limbs(y, n);
+			if (x == y && nx != 0)
+				square_limbs(x, nx, t, R(), w);
+			else if (nx != 0 && ny != 0)
+				multiplies_limbs(x, nx, y, ny, t, R(), w);
+			reduce(t, r);
+		}
+
+		/**
+		 * [x, x + nx) below m => r in this form
+		 */
+		void enter(const T* x, std::size_t nx, T* r, workspace& w) const {
+			workspace::frame frame(w);
+			nx = significant_limbs(x, nx);
+			T* const shifted = w.allocate<T>(n + nx);
+			T* const quotient = w.allocate<T>(nx + 1);
+			std::copy(x, x + nx, shifted + n);
+			divides_limbs(shifted, n + nx, m, n, quotient, r, R(), w);
+		}
+
+		/**
+		 * r in this form => [r, r + n)
+		 */
+		void leave(const T* x, T* r, workspace& w) const {
+			workspace::frame frame(w);
+			T* const t = w.allocate<T>(2 * n + 1);
+			std::copy(x, x + n, t);
+			reduce(t, r);
+		}
+};
+
+/**
+ * a^e => r, with a, r and the products in the residue form F
+ * e is little endian binary32 limbs with e[ne - 1] != 0
+ * Sliding windows: runs of up to k bits that start and end with a 1 take
+ * one product with an odd power of a from a table of 2^(k - 1), the zero
+ * bits between them only squares
+ */
+template<typename T, typename F>
+void power_limbs(const F& form, const T* a, const unsigned* e, std::size_t ne, T* r, workspace& w) {
+	// The window that keeps squares plus products least for each length
+	const std::size_t WINDOW_BITS[] = {7, 25, 81, 241, 673, 1793};
+	const std::size_t n = form.length();
+
+	std::size_t bits = 32 * ne;
+	while ((e[(bits - 1) / 32] >> (bits - 1) % 32 & 1) == 0)
+		--bits;
+	std::size_t k = 1;
+	while (k < 7 && bits > WINDOW_BITS[k - 1])
+		++k;
+
+	// table + i * n holds a^(2i + 1)
+	workspace::frame frame(w);
+	T* const table = w.allocate<T>(n << (k - 1));
+	std::copy(a, a + n, table);
+	if (k > 1) {
+		T* const square = w.allocate<T>(n);
+		form.multiply(a, a, square, w);
+		for (std::size_t i = 1; i < static_cast<std::size_t>(1) << (k - 1); ++i)
+			form.multiply(table + (i - 1) * n, square, table + i * n, w);
+	}
+
+	// Bits [0, i) are still to go, the top one is set
+	bool started = false;
+	for (std::size_t i = bits; i > 0;) {
+		if ((e[(i - 1) / 32] >> (i - 1) % 32 & 1) == 0) {
+			form.multiply(r, r, r, w);
+			--i;
+			continue;
+		}
+
+		std::size_t j = i > k ? i - k : 0;
+		while ((e[j / 32] >> j % 32 & 1) == 0)
+			++j;
+		std::size_t window = 0;
+		for (std::size_t l = i; l-- > j;)
+			window = 2 * window + (e[l / 32] >> l % 32 & 1);
+
+		if (started) {
+			for (std::size_t l = j; l < i; ++l)
+				form.multiply(r, r, r, w);
+			form.multiply(r, table + window / 2 * n, r, w);
+		}
+		else
+			std::copy(table + window / 2 * n, table + (window / 2 + 1) * n, r);
+		started = true;
+		i = j;
+	}
+}
+
+/**
+ * [a, a + na)^[e, e + ne) mod [m, m + nm) => [r, r + nm)
+ * a below m, e little endian binary32 limbs, m[nm - 1] != 0
+ * Montgomery form whenever m is prime to the base, otherwise Barrett's
+ */
+template<typename T, typename R>
+void powmod_limbs(const T* a, std::size_t na, const unsigned* e, std::size_t ne, const T* m, std::size_t nm, T* r, R radix, workspace& w) {
+	std::fill(r, r + nm, 0);
+	if (nm == 1 && m[0] == 1)
+		return;
+	if (ne == 0) {
+		r[0] = 1;
+		return;
+	}
+
+	workspace::frame frame(w);
+	T* const x = w.allocate<T>(nm);
+	const T inverse = montgomery_inverse(m[0], radix);
+	if (inverse != 0) {
+		const montgomery_form<T, R> form(m, nm, inverse);
+		form.enter(a, na, x, w);
+		power_limbs(form, x, e, ne, r, w);
+		form.leave(r, r, w);
+	}
+	else {
+		T* const mu = w.allocate<T>(nm + 2);
+		barrett_form<T, R>::reciprocal(m, nm, mu, w);
+		const barrett_form<T, R> form(m, nm, mu);
+		form.enter(a, na, x, w);
+		power_limbs(form, x, e, ne, r, w);
+	}
+}
+
+/**
+ * Decimal digits are worked on nine at a time, packed into base 10^9 limbs
+ */
+template<typename T>
+void powmod_limbs(const T* a, std::size_t na, const unsigned* e, std::size_t ne, const T* m, std::size_t nm, T* r, decimal_radix, workspace& w) {
+	workspace::frame frame(w);
+	const std::size_t packedNa = decimal9_limbs(na);
+	const std::size_t packedNm = decimal9_limbs(nm);
+	unsigned* const packedA = w.allocate<unsigned>(packedNa);
+	unsigned* const packedM = w.allocate<unsigned>(packedNm);
+	pack_decimal9(a, na, packedA);
+	pack_decimal9(m, nm, packedM);
+
+	unsigned* const packedR = w.allocate<unsigned>(packedNm);
+	powmod_limbs(packedA, packedNa, e, ne, packedM, packedNm, packedR, decimal9_radix(), w);
+	unpack_decimal9(packedR, r, nm);
+}
+
+/**
+ * @param b1 an iterator to the beginning of the base     sequence (inclusive)
+ * @param e1 an iterator to the end       of the base     sequence (exclusive)
+ * @param b2 an iterator to the beginning of the exponent sequence (inclusive)
+ * @param e2 an iterator to the end       of the exponent sequence (exclusive)
+ * @param b3 an iterator to the beginning of the modulus  sequence (inclusive)
+ * @param e3 an iterator to the end       of the modulus  sequence (exclusive)
+ * @param x  an iterator to the beginning of an output sequence (inclusive)
+ * @param r  the radix policy of all four sequences
+ * @param w  the workspace to draw scratch from
+ * @return   an iterator to the end       of an output sequence (exclusive)
+ * output the base to the exponent, mod the modulus, into the output sequence
+ * (([b1, e1) ^ [b2, e2)) % [b3, e3)) => x
+ */
+template<typename FI1, typename FI2, typename FI3, typename OI, typename R>
+OI powmod_digits(FI1 b1, FI1 e1, FI2 b2, FI2 e2, FI3 b3, FI3 e3, OI x, R r, workspace& w) {
+	typedef typename std::iterator_traits<OI>::value_type result_type;
+	typedef std::reverse_iterator<result_type*> result_list_iterator;
+	typedef typename std::iterator_traits<FI1>::iterator_category iCat1;
+	typedef typename std::iterator_traits<FI3>::iterator_category iCat3;
+
+	workspace::frame frame(w);
+	result_type* a;
+	result_type* m;
+	std::size_t na = copy_limbs(b1, e1, a, w, iCat1());
+	const std::size_t nm = copy_limbs(b3, e3, m, w, iCat3());
+	assert(nm > 0 && "can't reduce mod zero");
+
+	// A base past the modulus is reduced first
+	if (compare_limbs(a, na, m, nm) >= 0) {
+		result_type* const quotient = w.allocate<result_type>(na - nm + 1);
+		result_type* const remainder = w.allocate<result_type>(nm);
+		divides_limbs(a, na, m, nm, quotient, remainder, r, w);
+		a = remainder;
+		na = significant_limbs(remainder, nm);
+	}
+
+	const std::vector<unsigned> e = binary32_limbs(b2, e2, r);
+	result_type* const result = w.allocate<result_type>(nm);
+	powmod_limbs(a, na, e.empty() ? 0 : &e[0], e.size(), m, nm, result, r, w);
+	return print_list(result_list_iterator(result + nm), result_list_iterator(result), x);
+}
+
+/**
+ * scratch comes from this thread's workspace
+ * (([b1, e1) ^ [b2, e2)) % [b3, e3)) => x
+ */
+template<typename FI1, typename FI2, typename FI3, typename OI, typename R>
+OI powmod_digits(FI1 b1, FI1 e1, FI2 b2, FI2 e2, FI3 b3, FI3 e3, OI x, R r) {
+	return powmod_digits(b1, e1, b2, e2, b3, e3, x, r, default_workspace());
+}
+
+/**
+ * the sequences are of decimal digits
+ * (([b1, e1) ^ [b2, e2)) % [b3, e3)) => x
+ */
+template<typename FI1, typename FI2, typename FI3, typename OI>
+OI powmod_digits(FI1 b1, FI1 e1, FI2 b2, FI2 e2, FI3 b3, FI3 e3, OI x) {
+	return powmod_digits(b1, e1, b2, e2, b3, e3, x, decimal_radix());
+}
+
+// ---
+// GCD
+// ---
+
+/**
+ * @return gcd(a, b) by Stein's binary method, for values that fit a word
+ */
+template<typename W>
+W binary_gcd(W a, W b) {
+	if (a == 0 || b == 0)
+		return a | b;
+	int shift = 0;
+	while (((a | b) & 1) == 0) {
+		a >>= 1;
+		b >>= 1;
+		++shift;
+	}
+	while ((a & 1) == 0)
+		a >>= 1;
+	do {
+		while ((b & 1) == 0)
+			b >>= 1;
+		if (a > b)
+			std::swap(a, b);
+		b -= a;
+	} while (b != 0);
+	return a << shift;
+}
+
+/**
+ * Runs Euclid on the leading words x >= y of two numbers as far as the
+ * quotients are sure to match the numbers' own (Lehmer, Knuth's Algorithm L)
+ * and leaves the steps as the cofactors
+ * (u, v) => (a * u + b * v, c * u + d * v), b == 0 when not one step is sure
+ */
+template<typename S>
+void lehmer_cofactors(S x, S y, S& a, S& b, S& c, S& d) {
+	a = 1;
+	b = 0;
+	c = 0;
+	d = 1;
+	while (y + c != 0 && y + d != 0) {
+		const S q = (x + a) / (y + c);
+		if (q != (x + b) / (y + d))
+			break;
+		S t = a - q * c;
+		a = c;
+		c = t;
+		t = b - q * d;
+		b = d;
+		d = t;
+		t = x - q * y;
+		x = y;
+		y = t;
+	}
+}
+
+/**
+ * a * [x, x + n) + b * [y, y + n) => [r, r + n)
+ * a and b are Lehmer cofactors, of opposite signs and small enough that
+ * either product fits a signed wide word, and the result is known to be a
+ * non-negative number below B^n
+ */
+template<typename T, typename R>
+void combine_limbs(const T* x, typename R::signed_wide_type a, const T* y, typename R::signed_wide_type b, std::size_t n, T* r, R) {
+	typedef typename R::signed_wide_type signed_wide_type;
+	const signed_wide_type B = R::base();
+
+	signed_wide_type carry = 0;
+	for (std::size_t i = 0; i < n; ++i) {
+		const signed_wide_type sum = a * static_cast<signed_wide_type>(x[i]) + b * static_cast<signed_wide_type>(y[i]) + carry;
+		signed_wide_type digit = sum % B;
+		if (digit < 0)
+			digit += B;
+		r[i] = static_cast<T>(digit);
+		carry = (sum - digit) / B;
+	}
+	assert(carry == 0);
+}
+
+/**
+ * @return a * x + b * y for cofactors a and b
+ */
+template<typename T, typename R>
+signed_limbs<T> combine_signed_limbs(const signed_limbs<T>& x, typename R::signed_wide_type a, const signed_limbs<T>& y, typename R::signed_wide_type b, R radix) {
+	typedef typename R::wide_type wide_type;
+	typedef typename R::signed_wide_type signed_wide_type;
+
+	signed_limbs<T> terms[2];
+	const signed_limbs<T>* const operands[] = {&x, &y};
+	const signed_wide_type factors[] = {a, b};
+	for (std::size_t k = 0; k < 2; ++k) {
+		const std::vector<T>& digits = operands[k]->digits;
+		const wide_type factor = factors[k] < 0 ? -factors[k] : factors[k];
+		if (digits.empty() || factor == 0)
+			continue;
+		terms[k].digits.resize(digits.size() + 1);
+		wide_type carry = 0;
+		for (std::size_t i = 0; i < digits.size(); ++i) {
+			carry += static_cast<wide_type>(digits[i]) * factor;
+			terms[k].digits[i] = carry % R::base();
+			carry /= R::base();
+		}
+		terms[k].digits[digits.size()] = carry;
+		terms[k].digits.resize(significant_limbs(&terms[k].digits[0], terms[k].digits.size()));
+		terms[k].negative = operands[k]->negative != (factors[k] < 0);
+	}
+	return plus_signed_limbs(terms[0], terms[1], false, radix);
+}
+
+/**
+ * gcd([u, u + nu), [v, v + nv)) => [g, g + max(nu, nv))
+ * @return the length of the gcd, 0 when both are 0
+ * With s the cofactor of u comes back in it too, g = s * u mod v
+ * Lehmer: Euclid runs on the leading words while their quotients match,
+ * then the steps go onto the whole numbers as one combination, so most of
+ * the work is linear passes instead of long divisions; a long division
+ * only comes in when the leading words can't tell a quotient.  Without a
+ * cofactor two limb values are finished off by binary_gcd.
+ */
+template<typename T, typename R>
+std::size_t gcd_limbs(const T* u, std::size_t nu, const T* v, std::size_t nv, T* g, signed_limbs<T>* s, R radix, workspace& w) {
+	typedef typename R::wide_type wide_type;
+	typedef typename R::signed_wide_type signed_wide_type;
+
+	// Leading words below WORD keep the cofactors small enough that a
+	// cofactor times a limb still fits a signed wide word
+	const wide_type WORD = (~static_cast<wide_type>(0) >> 2) / R::base();
+
+	nu = significant_limbs(u, nu);
+	nv = significant_limbs(v, nv);
+	const std::size_t n = std::max(nu, nv) + 1;
+	workspace::frame frame(w);
+	T* x = w.allocate<T>(n);
+	T* y = w.allocate<T>(n);
+	T* spare1 = w.allocate<T>(n);
+	T* spare2 = w.allocate<T>(n);
+	T* const quotient = w.allocate<T>(n);
+	std::copy(u, u + nu, x);
+	std::copy(v, v + nv, y);
+	std::size_t nx = nu;
+	std::size_t ny = nv;
+
+	// x = sx * u + ... and y = sy * u + ...
+	signed_limbs<T> sx;
+	signed_limbs<T> sy;
+	if (nx != 0)
+		sx.digits.assign(1, 1);
+
+	for (;;) {
+		if (compare_limbs(x, nx, y, ny) < 0) {
+			std::swap(x, y);
+			std::swap(nx, ny);
+			std::swap(sx, sy);
+		}
+		if (ny == 0)
+			break;
+
+		if (s == 0 && nx <= 2) {
+			wide_type a = 0;
+			wide_type b = 0;
+			for (std::size_t i = nx; i-- > 0;) {
+				a = a * R::base() + x[i];
+				b = b * R::base() + (i < ny ? y[i] : 0);
+			}
+			a = binary_gcd(a, b);
+			std::fill(x, x + n, 0);
+			for (nx = 0; a != 0; ++nx) {
+				x[nx] = a % R::base();
+				a /= R::base();
+			}
+			break;
+		}
+
+		// The leading words, x and y over the same power of the base and
+		// the same small divisor that brings x below WORD
+		const std::size_t top = nx - 1;
+		wide_type xTop = x[top];
+		wide_type yTop = ny > top ? y[top] : 0;
+		if (top > 0) {
+			xTop = xTop * R::base() + x[top - 1];
+			yTop = yTop * R::base() + (ny > top - 1 ? y[top - 1] : 0);
+		}
+		const wide_type divisor = xTop / WORD + 1;
+		signed_wide_type a, b, c, d;
+		lehmer_cofactors<signed_wide_type>(xTop / divisor, yTop / divisor, a, b, c, d);
+
+		if (b == 0) {
+			// x, y => y, x % y
+			divides_limbs(x, nx, y, ny, quotient, spare1, radix, w);
+			if (s != 0) {
+				signed_limbs<T> q(quotient, nx - ny + 1);
+				sx = plus_signed_limbs(sx, multiplies_signed_limbs(q, sy, radix, w), true, radix);
+			}
+			std::fill(spare1 + ny, spare1 + n, 0);
+			std::swap(x, spare1);
+			std::swap(x, y);
+			nx = ny;
+			ny = significant_limbs(y, ny);
+			std::swap(sx, sy);
+		}
+		else {
+			std::fill(y + ny, y + nx, 0);
+			combine_limbs(x, a, y, b, nx, spare1, radix);
+			combine_limbs(x, c, y, d, nx, spare2, radix);
+			std::swap(x, spare1);
+			std::swap(y, spare2);
+			ny = significant_limbs(y, nx);
+			nx = significant_limbs(x, nx);
+			if (s != 0) {
+				const signed_limbs<T> sxNext = combine_signed_limbs(sx, a, sy, b, radix);
+				sy = combine_signed_limbs(sx, c, sy, d, radix);
+				sx = sxNext;
+			}
+		}
+	}
+
+	std::copy(x, x + nx, g);
+	if (s != 0)
+		*s = sx;
+	return nx;
+}
+
+/**
+ * Decimal digits are worked on nine at a time, packed into base 10^9 limbs
+ */
+template<typename T>
+std::size_t gcd_limbs(const T* u, std::size_t nu, const T* v, std::size_t nv, T* g, signed_limbs<T>* s, decimal_radix, workspace& w) {
+	workspace::frame frame(w);
+	const std::size_t packedNu = decimal9_limbs(nu);
+	const std::size_t packedNv = decimal9_limbs(nv);
+	unsigned* const packedU = w.allocate<unsigned>(packedNu);
+	unsigned* const packedV = w.allocate<unsigned>(packedNv);
+	pack_decimal9(u, nu, packedU);
+	pack_decimal9(v, nv, packedV);
+
+	unsigned* const packedG = w.allocate<unsigned>(std::max(packedNu, packedNv));
+	signed_limbs<unsigned> packedS;
+	const std::size_t length = gcd_limbs(packedU, packedNu, packedV, packedNv, packedG, s != 0 ? &packedS : 0, decimal9_radix(), w);
+	const std::size_t digits = std::min(9 * length, std::max(nu, nv));
+	unpack_decimal9(packedG, g, digits);
+	if (s != 0) {
+		s->negative = packedS.negative;
+		s->digits.resize(9 * packedS.digits.size());
+		if (!packedS.digits.empty()) {
+			unpack_decimal9(&packedS.digits[0], &s->digits[0], s->digits.size());
+			s->digits.resize(significant_limbs(&s->digits[0], s->digits.size()));
+		}
+	}
+	return significant_limbs(g, digits);
+}
+
+/**
+ * @param b1 an iterator to the beginning of an input  sequence (inclusive)
+ * @param e1 an iterator to the end       of an input  sequence (exclusive)
+ * @param b2 an iterator to the beginning of an input  sequence (inclusive)
+ * @param e2 an iterator to the end       of an input  sequence (exclusive)
+ * @param x  an iterator to the beginning of an output sequence (inclusive)
+ * @param r  the radix policy of all three sequences
+ * @param w  the workspace to draw scratch from
+ * @return   an iterator to the end       of an output sequence (exclusive)
+ * output the greatest common divisor of the two input sequences into the
+ * output sequence, 0 when both are 0
+ * gcd([b1, e1), [b2, e2)) => x
+ */
+template<typename II1, typename II2, typename OI, typename R>
+OI gcd_digits(II1 b1, II1 e1, II2 b2, II2 e2, OI x, R r, workspace& w) {
+	typedef typename std::iterator_traits<OI>::value_type result_type;
+	typedef std::reverse_iterator<result_type*> result_list_iterator;
+	typedef typename std::iterator_traits<II1>::iterator_category iCat1;
+	typedef typename std::iterator_traits<II2>::iterator_category iCat2;
+
+	workspace::frame frame(w);
+	result_type* u;
+	result_type* v;
+	const std::size_t nu = copy_limbs(b1, e1, u, w, iCat1());
+	const std::size_t nv = copy_limbs(b2, e2, v, w, iCat2());
+	result_type* const g = w.allocate<result_type>(std::max<std::size_t>(std::max(nu, nv), 1));
+	const std::size_t ng = gcd_limbs(u, nu, v, nv, g, static_cast<signed_limbs<result_type>*>(0), r, w);
+	if (ng == 0) {
+		*x = 0;
+		return ++x;
+	}
+	return print_list(result_list_iterator(g + ng), result_list_iterator(g), x);
+}
+
+/**
+ * scratch comes from this thread's workspace
+ * gcd([b1, e1), [b2, e2)) => x
+ */
+template<typename II1, typename II2, typename OI, typename R>
+OI gcd_digits(II1 b1, II1 e1, II2 b2, II2 e2, OI x, R r) {
+	return gcd_digits(b1, e1, b2, e2, x, r, default_workspace());
+}
+
+/**
+ * the sequences are of decimal digits
+ * gcd([b1, e1), [b2, e2)) => x
+ */
+template<typename II1, typename II2, typename OI>
+OI gcd_digits(II1 b1, II1 e1, II2 b2, II2 e2, OI x) {
+	return gcd_digits(b1, e1, b2, e2, x, decimal_radix());
+}
+
+// --------------
+// Exact division
+// --------------
+
+/**
+ * @return true if [q, q + nq) * [v, v + nv) is [u, u + nu)
+ * For checking exact divisions in debug builds
+ */
+template<typename T, typename R>
+bool is_exact_quotient(const T* u, std::size_t nu, const T* v, std::size_t nv, const T* q, std::size_t nq, R radix, workspace& w) {
+	nq = significant_limbs(q, nq);
+	if (nq == 0)
+		return significant_limbs(u, nu) == 0;
+	workspace::frame frame(w);
+	T* const product = w.allocate<T>(nq + nv);
+	multiplies_limbs(q, nq, v, nv, product, radix, w);
+	return compare_limbs(product, nq + nv, u, nu) == 0;
+}
+
+/**
+ * @return v0^-1 mod B, for a v0 prime to the base B
+ * v0^3 is the inverse mod 8 and mod 10, so mod 2^k and 10^k bases only need
+ * Newton's steps, each of which doubles the low digits that are right
+ */
+template<typename T, typename R>
+typename R::wide_type hensel_inverse(T v0, R) {
+	typedef typename R::wide_type wide_type;
+	const wide_type B = R::base();
+
+	const wide_type v = v0;
+	wide_type x = v * v % B * v % B;
+	while (v * x % B != 1)
+		x = x * (B + 2 - v * x % B) % B;
+	return x;
+}
+
+/**
+ * [u, u + nu) / [v, v + nv) => [q, q + nu - nv + 1)
+ * Little endian, nu >= nv, v[nv - 1] != 0 and v divides u
+ * Hensel division from the low end (Jebelean): with v[0] prime to the base
+ * each quotient limb is the next limb of u times v[0]^-1 mod B, and since
+ * the remainder is known to be 0, only the limbs below the quotient's top
+ * are ever updated, so the work is the triangle nq * min(nq, nv) with no
+ * estimates or corrections.  Factors v[0] shares with the base are divided
+ * out of both first.  Long quotients of long divisors go to divides_limbs,
+ * whose recursion wins there.
+ */
+template<typename T, typename R>
+void divides_exact_limbs(const T* u, std::size_t nu, const T* v, std::size_t nv, T* q, R radix, workspace& w) {
+	typedef typename R::wide_type wide_type;
+	typedef typename R::signed_wide_type signed_wide_type;
+	typedef std::reverse_iterator<T*> reverse_limbs;
+	const wide_type B = R::base();
+	assert(nu >= nv && nv > 0 && v[nv - 1] != 0);
+
+	const std::size_t nq = nu - nv + 1;
+	std::fill(q, q + nq, 0);
+	if (std::min(nq, nv) >= burnikel_ziegler_threshold()) {
+		workspace::frame frame(w);
+		T* const r = w.allocate<T>(nv);
+		divides_limbs(u, nu, v, nv, q, r, radix, w);
+		assert(significant_limbs(r, nv) == 0 && "not an exact division");
+		return;
+	}
+
+	// Zero limbs at the bottom of v are at the bottom of u too
+	std::size_t shift = 0;
+	while (v[shift] == 0)
+		++shift;
+	workspace::frame frame(w);
+	T* const x = w.allocate<T>(nu - shift);
+	T* const y = w.allocate<T>(nv - shift);
+	std::copy(u + shift, u + nu, x);
+	std::copy(v + shift, v + nv, y);
+	std::size_t nx = significant_limbs(x, nu - shift);
+	std::size_t ny = nv - shift;
+
+	// Other factors the base shares with v leave with a one limb division
+	for (wide_type g = binary_gcd<wide_type>(y[0], B); g != 1; g = binary_gcd<wide_type>(y[0], B)) {
+		divides_digit(reverse_limbs(x + nx), reverse_limbs(x), g, reverse_limbs(x + nx), radix);
+		divides_digit(reverse_limbs(y + ny), reverse_limbs(y), g, reverse_limbs(y + ny), radix);
+		nx = significant_limbs(x, nx);
+		ny = significant_limbs(y, ny);
+	}
+
+	// Each quotient limb clears the lowest limb left of x
+	const std::size_t length = nx >= ny ? nx - ny + 1 : 0;
+	const wide_type inverse = hensel_inverse(y[0], radix);
+	for (std::size_t i = 0; i < length; ++i) {
+		const wide_type digit = static_cast<wide_type>(x[i]) * inverse % B;
+		if (i < nq)
+			q[i] = static_cast<T>(digit);
+		else
+			assert(digit == 0 && "not an exact division");
+
+		// x[i, length) -= digit * y
+		const std::size_t window = std::min(ny, length - i);
+		wide_type product = 0;
+		signed_wide_type difference = 0;
+		std::size_t j = 0;
+		for (; j < window; ++j) {
+			product += digit * y[j];
+			difference += static_cast<signed_wide_type>(x[i + j]) - static_cast<signed_wide_type>(product % B);
+			product /= B;
+			if (difference < 0) {
+				x[i + j] = difference + B;
+				difference = -1;
+			}
+			else {
+				x[i + j] = difference;
+				difference = 0;
+			}
+		}
+
+		// The top of the product and the borrow run on up
+		difference -= static_cast<signed_wide_type>(product);
+		for (; difference != 0 && i + j < length; ++j) {
+			difference += static_cast<signed_wide_type>(x[i + j]);
+			if (difference < 0) {
+				x[i + j] = difference + B;
+				difference = -1;
+			}
+			else {
+				x[i + j] = difference;
+				difference = 0;
+			}
+		}
+	}
+	assert(is_exact_quotient(u, nu, v, nv, q, nq, radix, w) && "not an exact division");
+}
+
+/**
+ * Decimal digits are worked on nine at a time, packed into base 10^9 limbs
+ */
+template<typename T>
+void divides_exact_limbs(const T* u, std::size_t nu, const T* v, std::size_t nv, T* q, decimal_radix, workspace& w) {
+	workspace::frame frame(w);
+	const std::size_t packedNu = decimal9_limbs(nu);
+	const std::size_t packedNv = decimal9_limbs(nv);
+	unsigned* const packedU = w.allocate<unsigned>(packedNu);
+	unsigned* const packedV = w.allocate<unsigned>(packedNv);
+	pack_decimal9(u, nu, packedU);
+	pack_decimal9(v, nv, packedV);
+
+	unsigned* const packedQ = w.allocate<unsigned>(packedNu - packedNv + 1);
+	divides_exact_limbs(packedU, packedNu, packedV, packedNv, packedQ, decimal9_radix(), w);
+	unpack_decimal9(packedQ, q, nu - nv + 1);
+}
+
+/**
+ * @param b1 an iterator to the beginning of an input  sequence (inclusive)
+ * @param e1 an iterator to the end       of an input  sequence (exclusive)
+ * @param b2 an iterator to the beginning of an input  sequence (inclusive)
+ * @param e2 an iterator to the end       of an input  sequence (exclusive)
+ * @param x  an iterator to the beginning of an output sequence (inclusive)
+ * @param r  the radix policy of all three sequences
+ * @param w  the workspace to draw scratch from
+ * @return   an iterator to the end       of an output sequence (exclusive)
+ * output the quotient of the two input sequences into the output sequence
+ * when the second is known to divide the first; debug builds check that
+ * it does
+ * ([b1, e1) / [b2, e2)) => x
+ */
+template<typename II1, typename II2, typename OI, typename R>
+OI divides_exact_digits(II1 b1, II1 e1, II2 b2, II2 e2, OI x, R r, workspace& w) {
+	typedef typename std::iterator_traits<OI>::value_type result_type;
+	typedef std::reverse_iterator<result_type*> result_list_iterator;
+	typedef typename std::iterator_traits<II1>::iterator_category iCat1;
+	typedef typename std::iterator_traits<II2>::iterator_category iCat2;
+
+	workspace::frame frame(w);
+	result_type* u;
+	result_type* v;
+	const std::size_t nu = copy_limbs(b1, e1, u, w, iCat1());
+	const std::size_t nv = copy_limbs(b2, e2, v, w, iCat2());
+	assert(nv > 0 && "can't divide by zero");
+
+	// Only 0 is divisible by something longer
+	if (nu < nv) {
+		assert(nu == 0 && "not an exact division");
+		*x++ = 0;
+		return x;
+	}
+
+	result_type* const quotient = w.allocate<result_type>(nu - nv + 1);
+	divides_exact_limbs(u, nu, v, nv, quotient, r, w);
+	return print_list(result_list_iterator(quotient + (nu - nv + 1)), result_list_iterator(quotient), x);
+}
+
+/**
+ * scratch comes from this thread's workspace
+ * ([b1, e1) / [b2, e2)) => x
+ */
+template<typename II1, typename II2, typename OI, typename R>
+OI divides_exact_digits(II1 b1, II1 e1, II2 b2, II2 e2, OI x, R r) {
+	return divides_exact_digits(b1, e1, b2, e2, x, r, default_workspace());
+}
+
+/**
+ * the sequences are of decimal digits
+ * ([b1, e1) / [b2, e2)) => x
+ */
+template<typename II1, typename II2, typename OI>
+OI divides_exact_digits(II1 b1, II1 e1, II2 b2, II2 e2, OI x) {
+	return divides_exact_digits(b1, e1, b2, e2, x, decimal_radix());
+}
+
+// ----
+// Bits
+// ----
+
+/**
+ * Radixes whose limbs are plain bits, where shifts are word moves
+ */
+template<typename R>
+struct is_binary_radix : std::false_type {
+};
+
+template<>
+struct is_binary_radix<binary32_radix> : std::true_type {
+};
+
+#ifdef __SIZEOF_INT128__
+template<>
+struct is_binary_radix<binary64_radix> : std::true_type {
+};
+#endif
+
+/**
+ * @return the little endian binary32 limbs [b, e) as big endian radix r
+ * digits in x, by way of decimal unless r is binary
+ */
+template<typename OI, typename R>
+OI radix_from_binary32(const unsigned* b, const unsigned* e, OI x, R r) {
+	typedef std::reverse_iterator<const unsigned*> limb_iterator;
+	std::vector<int> decimal;
+	radix_to_decimal(limb_iterator(e), limb_iterator(b), std::back_inserter(decimal), binary32_radix());
+	return decimal_to_radix(decimal.begin(), decimal.end(), x, r);
+}
+
+template<typename OI>
+OI radix_from_binary32(const unsigned* b, const unsigned* e, OI x, binary32_radix) {
+	typedef std::reverse_iterator<const unsigned*> limb_iterator;
+	return print_list(limb_iterator(e), limb_iterator(b), x);
+}
+
+#ifdef __SIZEOF_INT128__
+// Two 32 bit limbs make each 64 bit one
+template<typename OI>
+OI radix_from_binary32(const unsigned* b, const unsigned* e, OI x, binary64_radix) {
+	std::vector<unsigned long long> limbs((e - b + 1) / 2);
+	for (std::size_t i = 0; b + i != e; ++i)
+		limbs[i / 2] |= static_cast<unsigned long long>(b[i]) << (i % 2 * 32);
+	return print_list(limbs.rbegin(), limbs.rend(), x);
+}
+#endif
+
+/**
+ * [a, a + n) * 2^bits => [r, r + n + bits / 32 + 1) in binary32 limbs
+ */
+inline void shift_left_limbs(const unsigned* a, std::size_t n, std::size_t bits, unsigned* r) {
+	const std::size_t words = bits / 32;
+	const unsigned shift = bits % 32;
+
+	std::fill(r, r + words, 0);
+	unsigned carry = 0;
+	for (std::size_t i = 0; i < n; ++i) {
+		r[words + i] = a[i] << shift | carry;
+		carry = shift == 0 ? 0 : a[i] >> (32 - shift);
+	}
+	r[words + n] = carry;
+}
+
+/**
+ * [a, a + n) / 2^bits => [r, r + n - bits / 32) in binary32 limbs, for
+ * bits / 32 < n
+ * @return true if any of the bits shifted out was 1
+ */
+inline bool shift_right_limbs(const unsigned* a, std::size_t n, std::size_t bits, unsigned* r) {
+	const std::size_t words = bits / 32;
+	const unsigned shift = bits % 32;
+	assert(words < n);
+
+	const bool lost = significant_limbs(a, words) != 0 || (shift != 0 && (a[words] & ((1u << shift) - 1)) != 0);
+	for (std::size_t i = words; i < n; ++i) {
+		const unsigned next = i + 1 < n && shift != 0 ? a[i + 1] << (32 - shift) : 0;
+		r[i - words] = a[i] >> shift | next;
+	}
+	return lost;
+}
+
+/**
+ * @return the index of the lowest 1 bit of [a, a + n) in binary32 limbs,
+ * which is not all zeroes
+ */
+inline std::size_t lowest_set_bit_limbs(const unsigned* a, std::size_t n) {
+	std::size_t i = 0;
+	while (a[i] == 0)
+		++i;
+	assert(i < n);
+	std::size_t index = 32 * i;
+	for (unsigned limb = a[i]; (limb & 1) == 0; limb >>= 1)
+		++index;
+	return index;
+}
+
+/**
+ * f([a, a + na), [b, b + nb)) => [r, r + max(na, nb) + 1) in binary32 limbs
+ * bit by bit in two's complement, so a negative operand reads as infinitely
+ * many 1 bits above its own
+ * a and b are magnitudes, negated when their flags are set, and so is r
+ * -m is ~m + 1, so each negative value takes a carry in at the bottom on
+ * its way into or out of two's complement
+ * @return true if r is negated
+ */
+template<typename F>
+bool bitwise_limbs(const unsigned* a, std::size_t na, bool aNegative, const unsigned* b, std::size_t nb, bool bNegative, unsigned* r, F f) {
+	const std::size_t n = std::max(na, nb) + 1;
+	const bool negative = f(aNegative ? ~0u : 0, bNegative ? ~0u : 0) != 0;
+
+	unsigned long long aCarry = aNegative;
+	unsigned long long bCarry = bNegative;
+	unsigned long long rCarry = negative;
+	for (std::size_t i = 0; i < n; ++i) {
+		unsigned x = i < na ? a[i] : 0;
+		unsigned y = i < nb ? b[i] : 0;
+		if (aNegative) {
+			aCarry += static_cast<unsigned>(~x);
+			x = static_cast<unsigned>(aCarry);
+			aCarry >>= 32;
+		}
+		if (bNegative) {
+			bCarry += static_cast<unsigned>(~y);
+			y = static_cast<unsigned>(bCarry);
+			bCarry >>= 32;
+		}
+		unsigned z = f(x, y);
+		if (negative) {
+			rCarry += static_cast<unsigned>(~z);
+			z = static_cast<unsigned>(rCarry);
+			rCarry >>= 32;
+		}
+		r[i] = z;
+	}
+	return negative;
+}
+
+// ------------
+// small_vector
+// ------------
+
+/**
+ * A vector of built-in integers that keeps its first N elements inside the
+ * object and only goes to the heap when it grows past them, so word sized
+ * Integers never allocate.  It has the parts of the std::vector interface
+ * the Integer and the kernels use, with pointers for iterators.
+ */
+template<typename T, std::size_t N>
+class small_vector {
+	public:
+		typedef T value_type;
+		typedef T& reference;
+		typedef const T& const_reference;
+		typedef T* pointer;
+		typedef const T* const_pointer;
+		typedef T* iterator;
+		typedef const T* const_iterator;
+		typedef std::reverse_iterator<iterator> reverse_iterator;
+		typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+		typedef std::size_t size_type;
+		typedef std::ptrdiff_t difference_type;
+
+	private:
+		T* first;
+		std::size_t length;
+		std::size_t room;
+		T local[N];
+
+		bool on_heap() const {
+			return first != local;
+		}
+
+		// Two integers of the same type are a count and a value, not a range
+		template<typename I>
+		void assign_dispatch(I n, I value, std::true_type) {
+			assign(static_cast<std::size_t>(n), static_cast<T>(value));
+		}
+
+		template<typename II>
+		void assign_dispatch(II b, II e, std::false_type) {
+			assign_range(b, e, typename std::iterator_traits<II>::iterator_category());
+		}
+
+		template<typename II>
+		void assign_range(II b, II e, std::input_iterator_tag) {
+			clear();
+			while (b != e)
+				push_back(*b++);
+		}
+
+		template<typename FI>
+		void assign_range(FI b, FI e, std::forward_iterator_tag) {
+			const std::size_t n = std::distance(b, e);
+			length = 0;
+			reserve(n);
+			std::copy(b, e, first);
+			length = n;
+		}
+
+		// Room for at least n, growing geometrically
+		void grow(std::size_t n) {
+			if (n > room)
+				reserve(std::max(n, 2 * room));
+		}
+
+	public:
+		small_vector() :
+				first(local),
+				length(0),
+				room(N) {
+		}
+
+		explicit small_vector(std::size_t n, const T& value = T()) :
+				first(local),
+				length(0),
+				room(N) {
+			assign(n, value);
+		}
+
+		template<typename II>
+		small_vector(II b, II e) :
+				first(local),
+				length(0),
+				room(N) {
+			assign(b, e);
+		}
+
+		small_vector(const small_vector& that) :
+				first(local),
+				length(0),
+				room(N) {
+			assign(that.begin(), that.end());
+		}
+
+		// A heap buffer is taken over, inline elements are copied into the
+		// room for N this already has, so neither move can throw
+		small_vector(small_vector&& that) noexcept :
+				first(local),
+				length(0),
+				room(N) {
+			*this = std::move(that);
+		}
+
+		~small_vector() {
+			if (on_heap())
+				delete[] first;
+		}
+
+		small_vector& operator =(const small_vector& that) {
+			if (this != &that)
+				assign(that.begin(), that.end());
+			return *this;
+		}
+
+		small_vector& operator =(small_vector&& that) noexcept {
+			if (this == &that)
+				return *this;
+			if (!that.on_heap()) {
+				assign(that.begin(), that.end());
+				that.length = 0;
+				return *this;
+			}
+			if (on_heap())
+				delete[] first;
+			first = that.first;
+			length = that.length;
+			room = that.room;
+			that.first = that.local;
+			that.length = 0;
+			that.room = N;
+			return *this;
+		}
+
+		iterator begin() {
+			return first;
+		}
+
+		const_iterator begin() const {
+			return first;
+		}
+
+		iterator end() {
+			return first + length;
+		}
+
+		const_iterator end() const {
+			return first + length;
+		}
+
+		reverse_iterator rbegin() {
+			return reverse_iterator(end());
+		}
+
+		const_reverse_iterator rbegin() const {
+			return const_reverse_iterator(end());
+		}
+
+		reverse_iterator rend() {
+			return reverse_iterator(begin());
+		}
+
+		const_reverse_iterator rend() const {
+			return const_reverse_iterator(begin());
+		}
+
+		std::size_t size() const {
+			return length;
+		}
+
+		std::size_t capacity() const {
+			return room;
+		}
+
+		bool empty() const {
+			return length == 0;
+		}
+
+		T& operator [](std::size_t i) {
+			return first[i];
+		}
+
+		const T& operator [](std::size_t i) const {
+			return first[i];
+		}
+
+		T& front() {
+			return first[0];
+		}
+
+		const T& front() const {
+			return first[0];
+		}
+
+		T& back() {
+			return first[length - 1];
+		}
+
+		const T& back() const {
+			return first[length - 1];
+		}
+
+		void reserve(std::size_t n) {
+			if (n <= room)
+				return;
+			T* p = new T[n];
+			std::copy(first, first + length, p);
+			if (on_heap())
+				delete[] first;
+			first = p;
+			room = n;
+		}
+
+		void clear() {
+			length = 0;
+		}
+
+		void assign(std::size_t n, const T& value) {
+			length = 0;
+			reserve(n);
+			std::fill(first, first + n, value);
+			length = n;
+		}
+
+		template<typename II>
+		void assign(II b, II e) {
+			assign_dispatch(b, e, std::is_integral<II>());
+		}
+
+		void resize(std::size_t n, const T& value = T()) {
+			grow(n);
+			if (n > length)
+				std::fill(first + length, first + n, value);
+			length = n;
+		}
+
+		void push_back(const T& value) {
+			grow(length + 1);
+			first[length++] = value;
+		}
+
+		void pop_back() {
+			--length;
+		}
+
+		iterator insert(iterator i, std::size_t n, const T& value) {
+			const std::size_t offset = i - first;
+			grow(length + n);
+			std::copy_backward(first + offset, first + length, first + length + n);
+			std::fill(first + offset, first + offset + n, value);
+			length += n;
+			return first + offset;
+		}
+
+		iterator insert(iterator i, const T& value) {
+			return insert(i, 1, value);
+		}
+
+		iterator erase(iterator b, iterator e) {
+			std::copy(e, end(), b);
+			length -= e - b;
+			return b;
+		}
+
+		iterator erase(iterator i) {
+			return erase(i, i + 1);
+		}
+
+		void swap(small_vector& that) {
+			if (on_heap() && that.on_heap()) {
+				std::swap(first, that.first);
+				std::swap(length, that.length);
+				std::swap(room, that.room);
+				return;
+			}
+			small_vector t(std::move(that));
+			that = std::move(*this);
+			*this = std::move(t);
+		}
+};
+
+// -----------
+// Expressions
+// -----------
+
+/*
+ * operator+, operator- and operator* on Integers return these nodes instead
+ * of new Integers.  Assigning a tree to an Integer walks it as a sum of
+ * signed terms: every product is multiplied into one scratch buffer and
+ * added in place into the destination, so a * b + c * d - e makes no
+ * temporary Integers.  The leaves refer to their Integers, so a tree must
+ * not outlive the full expression that built it.
+ */
+
+/**
+ * The base of every node, E is the node itself and I the Integer it makes
+ */
+template<typename I, typename E>
+struct integer_expression {
+	typedef I integer_type;
+
+	const E& self() const {
+		return static_cast<const E&>(*this);
+	}
+};
+
+/**
+ * A leaf, one Integer used in place
+ */
+template<typename I>
+struct integer_term : integer_expression<I, integer_term<I> > {
+	const I& value;
+
+	explicit integer_term(const I& x) :
+			value(x) {
+	}
+
+	bool aliases(const I& x) const {
+		return &value == &x;
+	}
+
+	void accumulate_into(I& x, bool negative, typename I::scratch&) const {
+		x.accumulate(value.data.begin(), value.data.end(), negative != !value.positive);
+	}
+};
+
+/**
+ * lhs + rhs, or lhs - rhs when SUBTRACT is set
+ */
+template<typename I, typename L, typename Rt, bool SUBTRACT>
+struct sum_expression : integer_expression<I, sum_expression<I, L, Rt, SUBTRACT> > {
+	L lhs;
+	Rt rhs;
+
+	sum_expression(const L& l, const Rt& r) :
+			lhs(l),
+			rhs(r) {
+	}
+
+	bool aliases(const I& x) const {
+		return lhs.aliases(x) || rhs.aliases(x);
+	}
+
+	void accumulate_into(I& x, bool negative, typename I::scratch& s) const {
+		lhs.accumulate_into(x, negative, s);
+		rhs.accumulate_into(x, negative != SUBTRACT, s);
+	}
+};
+
+/**
+ * lhs * rhs, fused with the sum it is part of
+ */
+template<typename I, typename L, typename Rt>
+struct product_expression : integer_expression<I, product_expression<I, L, Rt> > {
+	L lhs;
+	Rt rhs;
+
+	product_expression(const L& l, const Rt& r) :
+			lhs(l),
+			rhs(r) {
+	}
+
+	bool aliases(const I& x) const {
+		return lhs.aliases(x) || rhs.aliases(x);
+	}
+
+	void accumulate_into(I& x, bool negative, typename I::scratch& s) const {
+		x.multiply_accumulate(operand(lhs), operand(rhs), negative, s);
+	}
+
+	private:
+		// Leaves multiply in place, nested sums are evaluated first
+		static const I& operand(const integer_term<I>& e) {
+			return e.value;
+		}
+
+		template<typename E>
+		static I operand(const integer_expression<I, E>& e) {
+			return I(e);
+		}
+};
+
+/**
+ * Returns the lazy sum of lhs and rhs
+ */
+template<typename I, typename L, typename Rt>
+sum_expression<I, L, Rt, false> operator +(const integer_expression<I, L>& lhs, const integer_expression<I, Rt>& rhs) {
+	return sum_expression<I, L, Rt, false>(lhs.self(), rhs.self());
+}
+
+template<typename I, typename L>
+sum_expression<I, L, integer_term<I>, false> operator +(const integer_expression<I, L>& lhs, const typename integer_expression<I, L>::integer_type& rhs) {
+	return sum_expression<I, L, integer_term<I>, false>(lhs.self(), integer_term<I>(rhs));
+}
+
+template<typename I, typename Rt>
+sum_expression<I, integer_term<I>, Rt, false> operator +(const typename integer_expression<I, Rt>::integer_type& lhs, const integer_expression<I, Rt>& rhs) {
+	return sum_expression<I, integer_term<I>, Rt, false>(integer_term<I>(lhs), rhs.self());
+}
+
+// An expiring Integer takes the value in its own storage
+template<typename I, typename L>
+I operator +(const integer_expression<I, L>& lhs, typename integer_expression<I, L>::integer_type&& rhs) {
+	rhs += lhs.self();
+	return std::move(rhs);
+}
+
+template<typename I, typename Rt>
+I operator +(typename integer_expression<I, Rt>::integer_type&& lhs, const integer_expression<I, Rt>& rhs) {
+	lhs += rhs.self();
+	return std::move(lhs);
+}
+
+/**
+ * Returns the lazy difference of lhs and rhs
+ */
+template<typename I, typename L, typename Rt>
+sum_expression<I, L, Rt, true> operator -(const integer_expression<I, L>& lhs, const integer_expression<I, Rt>& rhs) {
+	return sum_expression<I, L, Rt, true>(lhs.self(), rhs.self());
+}
+
+template<typename I, typename L>
+sum_expression<I, L, integer_term<I>, true> operator -(const integer_expression<I, L>& lhs, const typename integer_expression<I, L>::integer_type& rhs) {
+	return sum_expression<I, L, integer_term<I>, true>(lhs.self(), integer_term<I>(rhs));
+}
+
+template<typename I, typename Rt>
+sum_expression<I, integer_term<I>, Rt, true> operator -(const typename integer_expression<I, Rt>::integer_type& lhs, const integer_expression<I, Rt>& rhs) {
+	return sum_expression<I, integer_term<I>, Rt, true>(integer_term<I>(lhs), rhs.self());
+}
+
+template<typename I, typename L>
+I operator -(const integer_expression<I, L>& lhs, typename integer_expression<I, L>::integer_type&& rhs) {
+	rhs -= lhs.self();
+	return -std::move(rhs);
+}
+
+template<typename I, typename Rt>
+I operator -(typename integer_expression<I, Rt>::integer_type&& lhs, const integer_expression<I, Rt>& rhs) {
+	lhs -= rhs.self();
+	return std::move(lhs);
+}
+
+/**
+ * Returns the lazy product of lhs and rhs
+ */
+template<typename I, typename L, typename Rt>
+product_expression<I, L, Rt> operator *(const integer_expression<I, L>& lhs, const integer_expression<I, Rt>& rhs) {
+	return product_expression<I, L, Rt>(lhs.self(), rhs.self());
+}
+
+template<typename I, typename L>
+product_expression<I, L, integer_term<I> > operator *(const integer_expression<I, L>& lhs, const typename integer_expression<I, L>::integer_type& rhs) {
+	return product_expression<I, L, integer_term<I> >(lhs.self(), integer_term<I>(rhs));
+}
+
+template<typename I, typename Rt>
+product_expression<I, integer_term<I>, Rt> operator *(const typename integer_expression<I, Rt>::integer_type& lhs, const integer_expression<I, Rt>& rhs) {
+	return product_expression<I, integer_term<I>, Rt>(integer_term<I>(lhs), rhs.self());
+}
+
+template<typename I, typename L>
+I operator *(const integer_expression<I, L>& lhs, typename integer_expression<I, L>::integer_type&& rhs) {
+	rhs *= I(lhs.self());
+	return std::move(rhs);
+}
+
+template<typename I, typename Rt>
+I operator *(typename integer_expression<I, Rt>::integer_type&& lhs, const integer_expression<I, Rt>& rhs) {
+	lhs *= I(rhs.self());
+	return std::move(lhs);
+}
+
+/**
+ * Returns a new Integer with the negated value of e
+ */
+template<typename I, typename E>
+I operator -(const integer_expression<I, E>& e) {
+	return -I(e);
+}
+
+/**
+ * Thrown by the string constructors of Integer
+ * position() is the offset of the first character that is not a digit
+ */
+class parse_error : public std::invalid_argument {
+	public:
+		parse_error(const std::string& what, std::size_t position) :
+				std::invalid_argument(what),
+				offset(position) {
+		}
+
+		std::size_t position() const {
+			return offset;
+		}
+
+	private:
+		std::size_t offset;
+};
+
+/**
+ * T is the element type of the digit container C, and R the radix policy of
+ * the elements.  Binary radixes need an unsigned T that can hold a whole limb:
+ * Integer<unsigned, std::vector<unsigned>, binary32_radix>.
+ * The default container holds ten digits inline, enough for any int in base
+ * 10, so small Integers live without a heap allocation.
+ */
+template<typename T, typename C = small_vector<T, 10>, typename R = decimal_radix>
+class Integer {
+		typedef integer_term<Integer> term;
+
+		friend struct integer_term<Integer>;
+		template<typename I, typename L, typename Rt, bool SUBTRACT>
+		friend struct sum_expression;
+		template<typename I, typename L, typename Rt>
+		friend struct product_expression;
+
+		/**
+		 * Returns content equality
+		 */
+		friend bool operator ==(const Integer& lhs, const Integer& rhs) {
+			return lhs.positive == rhs.positive && lhs.data.size() == rhs.data.size()
+			       && std::equal(lhs.data.begin(), lhs.data.end(), rhs.data.begin());
+		}
+
+		/**
+		 * Returns the negation of content equality
+		 */
+		friend bool operator !=(const Integer& lhs, const Integer& rhs) {
+			return !(lhs == rhs);
+		}
+
+		/**
+		 * Returns true if the value of lhs is less than rhs
+		 * False otherwise
+		 */
+		friend bool operator <(const Integer& lhs, const Integer& rhs) {
+			// Easy +/- testing
+			if (lhs.positive != rhs.positive)
+				return !lhs.positive;
+
+			int cmp = compare(lhs.data.begin(), lhs.data.end(), rhs.data.begin(), rhs.data.end());
+			if (lhs.positive) {
+				assert(rhs.positive);
+				return cmp < 0;
+			}
+			else {
+				return cmp > 0;
+			}
+		}
+
+		/**
+		 * Returns true if the value of lhs is less than or equal to rhs
+		 * false otherwise
+		 */
+		friend bool operator <=(const Integer& lhs, const Integer& rhs) {
+			return !(rhs < lhs);
+		}
+
+		/**
+		 * Returns true if the value of lhs is greater than rhs
+		 * false otherwise
+		 */
+		friend bool operator >(const Integer& lhs, const Integer& rhs) {
+			return (rhs < lhs);
+		}
+
+		/**
+		 * Returns true if lhs is greater than or equal to rhs
+		 */
+		friend bool operator >=(const Integer& lhs, const Integer& rhs) {
+			return !(lhs < rhs);
+		}
+
+		/**
+		 * Compare with a built-in integer in place, without an Integer for it
+		 */
+		template<typename S>
+		friend typename std::enable_if<std::is_integral<S>::value, bool>::type operator ==(const Integer& lhs, S rhs) {
+			return lhs.compare_scalar(rhs) == 0;
+		}
+
+		template<typename S>
+		friend typename std::enable_if<std::is_integral<S>::value, bool>::type operator ==(S lhs, const Integer& rhs) {
+			return rhs.compare_scalar(lhs) == 0;
+		}
+
+		template<typename S>
+		friend typename std::enable_if<std::is_integral<S>::value, bool>::type operator !=(const Integer& lhs, S rhs) {
+			return lhs.compare_scalar(rhs) != 0;
+		}
+
+		template<typename S>
+		friend typename std::enable_if<std::is_integral<S>::value, bool>::type operator !=(S lhs, const Integer& rhs) {
+			return rhs.compare_scalar(lhs) != 0;
+		}
+
+		template<typename S>
+		friend typename std::enable_if<std::is_integral<S>::value, bool>::type operator <(const Integer& lhs, S rhs) {
+			return lhs.compare_scalar(rhs) < 0;
+		}
+
+		template<typename S>
+		friend typename std::enable_if<std::is_integral<S>::value, bool>::type operator <(S lhs, const Integer& rhs) {
+			return rhs.compare_scalar(lhs) > 0;
+		}
+
+		template<typename S>
+		friend typename std::enable_if<std::is_integral<S>::value, bool>::type operator <=(const Integer& lhs, S rhs) {
+			return lhs.compare_scalar(rhs) <= 0;
+		}
+
+		template<typename S>
+		friend typename std::enable_if<std::is_integral<S>::value, bool>::type operator <=(S lhs, const Integer& rhs) {
+			return rhs.compare_scalar(lhs) >= 0;
+		}
+
+		template<typename S>
+		friend typename std::enable_if<std::is_integral<S>::value, bool>::type operator >(const Integer& lhs, S rhs) {
+			return lhs.compare_scalar(rhs) > 0;
+		}
+
+		template<typename S>
+		friend typename std::enable_if<std::is_integral<S>::value, bool>::type operator >(S lhs, const Integer& rhs) {
+			return rhs.compare_scalar(lhs) < 0;
+		}
+
+		template<typename S>
+		friend typename std::enable_if<std::is_integral<S>::value, bool>::type operator >=(const Integer& lhs, S rhs) {
+			return lhs.compare_scalar(rhs) >= 0;
+		}
+
+		template<typename S>
+		friend typename std::enable_if<std::is_integral<S>::value, bool>::type operator >=(S lhs, const Integer& rhs) {
+			return rhs.compare_scalar(lhs) <= 0;
+		}
+
+		/**
+		 * Returns the lazy sum of lhs and rhs
+		 */
+		friend sum_expression<Integer, term, term, false> operator +(const Integer& lhs, const Integer& rhs) {
+			return sum_expression<Integer, term, term, false>(term(lhs), term(rhs));
+		}
+
+		/**
+		 * Returns the sum of lhs and rhs in the storage of the expiring one
+		 */
+		friend Integer operator +(Integer&& lhs, const Integer& rhs) {
+			lhs += rhs;
+			return std::move(lhs);
+		}
+
+		friend Integer operator +(const Integer& lhs, Integer&& rhs) {
+			rhs += lhs;
+			return std::move(rhs);
+		}
+
+		friend Integer operator +(Integer&& lhs, Integer&& rhs) {
+			lhs += std::move(rhs);
+			return std::move(lhs);
+		}
+
+		/**
+		 * Returns the lazy value of rhs subtracted from lhs
+		 */
+		friend sum_expression<Integer, term, term, true> operator -(const Integer& lhs, const Integer& rhs) {
+			return sum_expression<Integer, term, term, true>(term(lhs), term(rhs));
+		}
+
+		/**
+		 * Returns the value of rhs subtracted from lhs in the storage of the
+		 * expiring one
+		 */
+		friend Integer operator -(Integer&& lhs, const Integer& rhs) {
+			lhs -= rhs;
+			return std::move(lhs);
+		}
+
+		friend Integer operator -(const Integer& lhs, Integer&& rhs) {
+			rhs -= lhs;
+			return -std::move(rhs);
+		}
+
+		friend Integer operator -(Integer&& lhs, Integer&& rhs) {
+			lhs -= std::move(rhs);
+			return std::move(lhs);
+		}
+
+		/**
+		 * Returns the lazy product of lhs and rhs
+		 */
+		friend product_expression<Integer, term, term> operator *(const Integer& lhs, const Integer& rhs) {
+			return product_expression<Integer, term, term>(term(lhs), term(rhs));
+		}
+
+		/**
+		 * Returns the product of lhs and rhs, moved out of the expiring one
+		 */
+		friend Integer operator *(Integer&& lhs, const Integer& rhs) {
+			lhs *= rhs;
+			return std::move(lhs);
+		}
+
+		friend Integer operator *(const Integer& lhs, Integer&& rhs) {
+			rhs *= lhs;
+			return std::move(rhs);
+		}
+
+		friend Integer operator *(Integer&& lhs, Integer&& rhs) {
+			lhs *= rhs;
+			return std::move(lhs);
+		}
+
+		/**
+		 * Returns a new Integer with the value of lhs divided by rhs
+		 *
+		 * @throws invalid_argument if (rhs == 0)
+		 */
+		friend Integer operator /(Integer lhs, const Integer& rhs) {
+			lhs /= rhs;
+			return lhs;
+		}
+
+		/**
+		 * Returns the remainder of lhs divided by rhs
+		 *
+		 * @throws invalid_argument if (rhs <= 0)
+		 */
+		friend Integer operator %(Integer lhs, const Integer& rhs) {
+			lhs %= rhs;
+			return lhs;
+		}
+
+		/**
+		 * Returns a new Integer with the value of lhs divided by rhs, which
+		 * is known to divide it
+		 *
+		 * @throws invalid_argument if (rhs == 0)
+		 */
+		friend Integer divexact(Integer lhs, const Integer& rhs) {
+			lhs.divexact(rhs);
+			return lhs;
+		}
+
+		/**
+		 * Returns the quotient and the remainder of lhs divided by rhs, out
+		 * of one division
+		 *
+		 * @throws invalid_argument if (rhs == 0)
+		 */
+		friend std::pair<Integer, Integer> divmod(Integer lhs, const Integer& rhs) {
+			Integer remainder = 0;
+			lhs.divmod(rhs, remainder);
+			return std::make_pair(std::move(lhs), std::move(remainder));
+		}
+
+		/**
+		 * Divide by a built-in integer in one pass over the digits of lhs
+		 *
+		 * @throws invalid_argument if (rhs == 0)
+		 */
+		template<typename S>
+		friend typename std::enable_if<std::is_integral<S>::value, Integer>::type operator /(Integer lhs, S rhs) {
+			lhs /= rhs;
+			return lhs;
+		}
+
+		template<typename S>
+		friend typename std::enable_if<std::is_integral<S>::value, Integer>::type operator %(Integer lhs, S rhs) {
+			lhs %= rhs;
+			return lhs;
+		}
+
+		/**
+		 * Returns a new Integer with the bits of lhs and rhs in two's
+		 * complement combined, as if both had infinitely many sign bits
+		 */
+		friend Integer operator &(Integer lhs, const Integer& rhs) {
+			lhs &= rhs;
+			return lhs;
+		}
+
+		friend Integer operator |(Integer lhs, const Integer& rhs) {
+			lhs |= rhs;
+			return lhs;
+		}
+
+		friend Integer operator ^(Integer lhs, const Integer& rhs) {
+			lhs ^= rhs;
+			return lhs;
+		}
+
+		/**
+		 * Returns a new Integer with the value of lhs shifted rhs bits left
+		 *
+		 * @throws invalid_argument if (rhs < 0)
+		 */
+		friend Integer operator <<(Integer lhs, int rhs) {
+			lhs <<= rhs;
+			return lhs;
+		}
+
+		/**
+		 * Returns a new Integer with the value of lhs shifted rhs bits right
+		 *
+		 * @throws invalid_argument if (rhs < 0)
+		 */
+		friend Integer operator >>(Integer lhs, int rhs) {
+			lhs >>= rhs;
+			return lhs;
+		}
+
+		/**
+		 * Prints this Integer to lhs
+		 */
+		friend std::ostream& operator <<(std::ostream& lhs, const Integer& rhs) {
+			const std::string s = to_string(rhs);
+			return lhs.write(s.data(), s.size());
+		}
+
+		/**
+		 * Returns the decimal digits of x, with a leading '-' if x is negative
+		 */
+		friend std::string to_string(const Integer& x) {
+			std::string s;
+			s.reserve(x.data.size() * decimal_digits_per_limb(R()) + 1);
+			if (!x.positive)
+				s += '-';
+			const std::size_t sign = s.size();
+			radix_to_decimal(x.data.begin(), x.data.end(), std::back_inserter(s), R());
+			for (std::string::iterator i = s.begin() + sign; i != s.end(); ++i)
+				*i += '0';
+			return s;
+		}
+
+		/**
+		 * Writes the decimal digits of x, with a leading '-' if x is negative,
+		 * into [first, last)
+		 *
+		 * @return one past the last character written, or 0 if [first, last)
+		 * is too short
+		 */
+		friend char* to_chars(char* first, char* last, const Integer& x) {
+			if (!x.positive) {
+				if (first == last)
+					return 0;
+				*first++ = '-';
+			}
+			const char_digit_iterator end = radix_to_decimal(x.data.begin(), x.data.end(), char_digit_iterator(first, last), R());
+			return end.overflow == 0 ? end.p : 0;
+		}
+
+		/**
+		 * Returns a new Integer with the absolute value of x
+		 */
+		friend Integer abs(Integer x) {
+			x.abs();
+			return x;
+		}
+
+		/**
+		 * Returns a new Integer with the value of x raised to the e power
+		 *
+		 * @throws invalid_argument if (x == 0) && (e == 0)
+		 * @throws invalid_argument if (e < 0)
+		 */
+		friend Integer pow(Integer x, int e) {
+			x.pow(e);
+			return x;
+		}
+
+		/**
+		 * Returns a new Integer with the value of x raised to the e power,
+		 * mod m, in [0, m)
+		 *
+		 * @throws invalid_argument if (e < 0) or (m <= 0)
+		 */
+		friend Integer powmod(Integer x, const Integer& e, const Integer& m) {
+			x.powmod(e, m);
+			return x;
+		}
+
+		/**
+		 * Returns a new Integer with the greatest common divisor of x and y,
+		 * never negative, 0 only when both are 0
+		 */
+		friend Integer gcd(Integer x, const Integer& y) {
+			x.gcd(y);
+			return x;
+		}
+
+		/**
+		 * Returns the greatest common divisor g of a and b, and sets x and
+		 * y so that a * x + b * y == g
+		 */
+		friend Integer extended_gcd(const Integer& a, const Integer& b, Integer& x, Integer& y) {
+			Integer s = 0;
+			const Integer g = a.gcd_cofactor(b, &s);
+			if (!a.positive)
+				s = -std::move(s);
+			Integer t = g;
+			if (!b.is_zero())
+				(t -= a * s).divexact(b);
+			else
+				t = 0;
+			x = s;
+			y = t;
+			return g;
+		}
+
+		/**
+		 * Returns a new Integer with the inverse of x mod m, in [0, m)
+		 *
+		 * @throws invalid_argument if (m <= 0) or x and m share a factor
+		 */
+		friend Integer mod_inverse(Integer x, const Integer& m) {
+			x.mod_inverse(m);
+			return x;
+		}
+
+		/**
+		 * Returns a new Integer with the value of x squared
+		 */
+		friend Integer square(Integer x) {
+			x.square();
+			return x;
+		}
+
+	private:
+		// Typedefs
+		typedef typename C::iterator C_iter;
+		typedef typename C::const_iterator C_const_iter;
+		typedef typename std::iterator_traits<C_iter>::difference_type C_diff_t;
+		typedef T* pointer;
+		typedef typename R::wide_type wide_type;
+
+		// data
+		C data;
+		bool positive;
+
+		// Reused by every product of an expression
+		struct scratch {
+			C product;
+		};
+
+	private:
+
+		bool valid() const {
+			bool result = true;
+			result &= (data.size() > 0);
+			for (C_const_iter i = data.begin(); i != data.end(); ++i)
+				result &= (*i >= 0 && static_cast<wide_type>(*i) < R::base());
+			return result;
+		}
+
+		// An optional '-' and at least one digit
+		void parse(const char* first, const char* last) {
+			const char* b = first;
+			if (b != last && *b == '-') {
+				positive = false;
+				++b;
+			}
+			if (b == last)
+				throw parse_error("Integer::Integer()", b - first);
+			parse_digits(first, b, last, R());
+			data.erase(data.begin(), strip_zeroes(data.begin(), data.end()));
+			if (data.empty())
+				data.push_back(0);
+			if (is_zero())
+				positive = true;
+			assert(valid());
+		}
+
+		// Decimal digits are stored as they are read
+		void parse_digits(const char* first, const char* b, const char* e, decimal_radix) {
+			data.resize(e - b);
+			C_iter j = data.begin();
+			for (const char* i = b; i != e; ++i, ++j) {
+				if (*i < '0' || *i > '9')
+					throw parse_error("Integer::Integer()", i - first);
+				*j = *i - '0';
+			}
+		}
+
+		// Any other radix packs nine digits per chunk, scanning from the
+		// right so the last bad character seen is the first in the string
+		template<typename R2>
+		void parse_digits(const char* first, const char* b, const char* e, R2 r) {
+			const std::size_t CHUNK_DIGITS = 9;
+			const std::size_t n = e - b;
+			std::vector<unsigned> chunks((n + CHUNK_DIGITS - 1) / CHUNK_DIGITS);
+			const unsigned POWERS[] = {1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000};
+			const char* bad = 0;
+			std::size_t i = 0;
+			for (const char* p = e; p-- != b; ++i) {
+				if (*p < '0' || *p > '9')
+					bad = p;
+				else
+					chunks[i / CHUNK_DIGITS] += (*p - '0') * POWERS[i % CHUNK_DIGITS];
+			}
+			if (bad != 0)
+				throw parse_error("Integer::Integer()", bad - first);
+			decimal9_to_radix<T>(chunks, std::back_inserter(data), r);
+		}
+
+		/**
+		 * Adds [b, e), most significant digit first and negated when
+		 * negative is set, to this Integer
+		 * Works in place from the least significant digit up, growing data at
+		 * the front only when the result is longer, so the storage is reused
+		 * [b, e) may be this Integer's own digits
+		 */
+		template<typename I>
+		void accumulate(I b, I e, bool negative) {
+			typedef typename R::signed_wide_type signed_wide_type;
+
+			b = strip_zeroes(b, e);
+			// Adding 0
+			if (b == e)
+				return;
+			if (is_zero()) {
+				data.assign(b, e);
+				positive = !negative;
+				return;
+			}
+
+			const std::size_t length = std::distance(b, e);
+			if (positive != negative) {
+				if (data.size() < length)
+					data.insert(data.begin(), length - data.size(), 0);
+				C_iter i = data.end();
+				bool laneCarry = false;
+				const std::size_t done = plus_digits_lanes(i, e, i, length, laneCarry, R());
+				std::advance(i, -static_cast<std::ptrdiff_t>(done));
+				std::advance(e, -static_cast<std::ptrdiff_t>(done));
+				wide_type carry = laneCarry;
+				while (b != e || carry != 0) {
+					if (i == data.begin()) {
+						data.insert(data.begin(), static_cast<T>(carry));
+						break;
+					}
+					--i;
+					carry += *i;
+					if (b != e)
+						carry += *--e;
+					*i = carry % R::base();
+					carry /= R::base();
+				}
+				assert(valid());
+				return;
+			}
+
+			// Opposite signs, the smaller magnitude comes off the larger one
+			const int cmp = compare(data.begin(), data.end(), b, e);
+			if (cmp == 0) {
+				data.assign(1, 0);
+				positive = true;
+				return;
+			}
+			if (cmp < 0) {
+				data.insert(data.begin(), length - data.size(), 0);
+				positive = !positive;
+			}
+			C_iter i = data.end();
+			bool laneBorrow = false;
+			const std::size_t done = cmp > 0 ? minus_digits_lanes(i, e, i, length, laneBorrow, R()) : minus_digits_lanes(e, i, i, length, laneBorrow, R());
+			std::advance(i, -static_cast<std::ptrdiff_t>(done));
+			std::advance(e, -static_cast<std::ptrdiff_t>(done));
+			signed_wide_type borrow = laneBorrow;
+			while (b != e || borrow != 0) {
+				--i;
+				signed_wide_type difference;
+				if (cmp > 0)
+					difference = static_cast<signed_wide_type>(*i) - (b != e ? static_cast<signed_wide_type>(*--e) : 0);
+				else
+					difference = static_cast<signed_wide_type>(*--e) - static_cast<signed_wide_type>(*i);
+				difference -= borrow;
+				borrow = difference < 0;
+				if (borrow)
+					difference += R::base();
+				*i = static_cast<T>(difference);
+			}
+			data.erase(data.begin(), strip_zeroes(data.begin(), data.end()));
+			assert(valid());
+		}
+
+		/**
+		 * Adds a * b, negated when negative is set, to this Integer
+		 * a or b may be this Integer
+		 */
+		void multiply_accumulate(const Integer& a, const Integer& b, bool negative, scratch& s) {
+			s.product.resize(a.data.size() + b.data.size());
+			C_iter endOfNumber = multiplies_digits(a.data.begin(), a.data.end(), b.data.begin(), b.data.end(), s.product.begin(), R());
+			accumulate(s.product.begin(), endOfNumber, negative != (a.positive != b.positive));
+		}
+
+		bool is_zero() const {
+			return data.size() == 1 && *data.begin() == 0;
+		}
+
+		// 1 or -1
+		bool is_unit() const {
+			return data.size() == 1 && *data.begin() == 1;
+		}
+
+		/**
+		 * @return gcd(|this|, |y|), with s, when not 0, set to the cofactor
+		 * of |this|: gcd == s * |this| + t * |y| for some t
+		 */
+		Integer gcd_cofactor(const Integer& y, Integer* s) const {
+			typedef typename std::iterator_traits<C_const_iter>::iterator_category iCat;
+			typedef std::reverse_iterator<T*> result_list_iterator;
+
+			workspace& w = default_workspace();
+			workspace::frame frame(w);
+			T* u;
+			T* v;
+			const std::size_t nu = copy_limbs(data.begin(), data.end(), u, w, iCat());
+			const std::size_t nv = copy_limbs(y.data.begin(), y.data.end(), v, w, iCat());
+			T* const g = w.allocate<T>(std::max<std::size_t>(std::max(nu, nv), 1));
+			signed_limbs<T> cofactor;
+			const std::size_t ng = gcd_limbs(u, nu, v, nv, g, s != 0 ? &cofactor : 0, R(), w);
+
+			Integer result = 0;
+			if (ng != 0) {
+				result.data.resize(ng);
+				print_list(result_list_iterator(g + ng), result_list_iterator(g), result.data.begin());
+			}
+			if (s != 0) {
+				*s = 0;
+				if (!cofactor.digits.empty()) {
+					s->data.assign(cofactor.digits.rbegin(), cofactor.digits.rend());
+					s->positive = !cofactor.negative;
+				}
+				assert(s->valid());
+			}
+			assert(result.valid());
+			return result;
+		}
+
+		// Built-in integers are worked on as a sign and a magnitude, the
+		// magnitude written out in this radix when it takes whole digits;
+		// 64 digits hold any 64 bit magnitude in any base
+		static const std::size_t SCALAR_DIGITS = 64;
+
+		template<typename S>
+		static bool scalar_negative(S value, std::true_type) {
+			return value < 0;
+		}
+
+		template<typename S>
+		static bool scalar_negative(S, std::false_type) {
+			return false;
+		}
+
+		template<typename S>
+		static unsigned long long scalar_magnitude(S value) {
+			const unsigned long long magnitude = static_cast<unsigned long long>(value);
+			return scalar_negative(value, std::is_signed<S>()) ? 0 - magnitude : magnitude;
+		}
+
+		/**
+		 * Writes magnitude into digits, most significant first
+		 * @return the number of digits, 1 for 0
+		 */
+		static std::size_t scalar_digits(unsigned long long magnitude, T* digits) {
+			std::size_t n = 0;
+			wide_type rest = magnitude;
+			do {
+				digits[SCALAR_DIGITS - ++n] = rest % R::base();
+				rest /= R::base();
+			} while (rest != 0);
+			std::copy(digits + SCALAR_DIGITS - n, digits + SCALAR_DIGITS, digits);
+			return n;
+		}
+
+		/**
+		 * @return an Integer with the value of a built-in integer
+		 */
+		template<typename S>
+		static Integer scalar(S value) {
+			T digits[SCALAR_DIGITS];
+			Integer result = 0;
+			result.data.assign(digits, digits + scalar_digits(scalar_magnitude(value), digits));
+			result.positive = !scalar_negative(value, std::is_signed<S>()) || result.is_zero();
+			return result;
+		}
+
+		/**
+		 * @return true if a magnitude fits the one word kernels, which need
+		 * magnitude * R::base() to fit the wide type
+		 */
+		static bool scalar_word(unsigned long long magnitude) {
+			return magnitude <= ~static_cast<wide_type>(0) / R::base();
+		}
+
+		/**
+		 * @return 1, 0 or -1 as this Integer is greater, equal or less than value
+		 */
+		template<typename S>
+		int compare_scalar(S value) const {
+			const bool negative = scalar_negative(value, std::is_signed<S>());
+			if (positive == negative)
+				return positive ? 1 : -1;
+			T digits[SCALAR_DIGITS];
+			const int cmp = compare(data.begin(), data.end(), digits, digits + scalar_digits(scalar_magnitude(value), digits));
+			return positive ? cmp : -cmp;
+		}
+
+		/**
+		 * Adds magnitude, negated when negative is set, to this Integer
+		 * The carry or borrow runs up from the last digit only as far as it
+		 * has to, so an increment is O(1) amortized; a borrow past the top,
+		 * where the sign flips, goes through accumulate
+		 */
+		void accumulate_scalar(unsigned long long magnitude, bool negative) {
+			T digits[SCALAR_DIGITS];
+			const std::size_t n = scalar_digits(magnitude, digits);
+			if (!scalar_word(magnitude) || is_zero() || (positive == negative && data.size() <= n && compare(data.begin(), data.end(), digits, digits + n) < 0)) {
+				accumulate(digits, digits + n, negative);
+				return;
+			}
+
+			wide_type carry = magnitude;
+			C_iter i = data.end();
+			if (positive != negative) {
+				while (carry != 0 && i != data.begin()) {
+					--i;
+					carry += *i;
+					*i = carry % R::base();
+					carry /= R::base();
+				}
+				for (; carry != 0; carry /= R::base())
+					data.insert(data.begin(), static_cast<T>(carry % R::base()));
+			}
+			else {
+				while (carry != 0) {
+					--i;
+					const wide_type digit = carry % R::base();
+					carry /= R::base();
+					if (static_cast<wide_type>(*i) < digit) {
+						*i = static_cast<T>(*i + (R::base() - digit));
+						++carry;
+					}
+					else
+						*i = static_cast<T>(*i - digit);
+				}
+				data.erase(data.begin(), strip_zeroes(data.begin(), std::prev(data.end())));
+				positive = positive || is_zero();
+			}
+			assert(valid());
+		}
+
+		/**
+		 * @return the magnitude of this Integer in little endian binary32
+		 * limbs, without leading zeroes
+		 */
+		std::vector<unsigned> magnitude_limbs() const {
+			return binary32_limbs(data.begin(), data.end(), R());
+		}
+
+		/**
+		 * Sets this Integer to the magnitude [b, e) in binary32 limbs,
+		 * negated when negative is set
+		 */
+		void assign_limbs(const unsigned* b, const unsigned* e, bool negative) {
+			data.clear();
+			radix_from_binary32(b, e, std::back_inserter(data), R());
+			positive = !negative || is_zero();
+			assert(valid());
+		}
+
+		/**
+		 * Combines this Integer with rhs bit by bit in two's complement
+		 */
+		template<typename F>
+		Integer& bitwise(const Integer& rhs, F f) {
+			const std::vector<unsigned> a = magnitude_limbs();
+			const std::vector<unsigned> b = rhs.magnitude_limbs();
+			std::vector<unsigned> r(std::max(a.size(), b.size()) + 1);
+			const bool negative = bitwise_limbs(a.empty() ? 0 : &a[0], a.size(), !positive, b.empty() ? 0 : &b[0], b.size(), !rhs.positive, &r[0], f);
+			assign_limbs(&r[0], &r[0] + r.size(), negative);
+			return *this;
+		}
+
+		// Short shifts multiply or divide the digits in passes of up to
+		// SHIFT_PASS_BITS.  Longer ones move words when the limbs are
+		// binary; any other radix multiplies or divides by 2^n, which costs
+		// less than converting to binary32 limbs and back
+		static const int SHIFT_PASS_BITS = 31;
+
+		// Passes beat one product up to four words, or one word over
+		// binary limbs, which shift as fast in a single pass
+		static int shift_pass_limit() {
+			return is_binary_radix<R>::value ? 32 : 128;
+		}
+
+		void shift_left_bits(int n, std::true_type) {
+			const std::vector<unsigned> a = magnitude_limbs();
+			std::vector<unsigned> r(a.size() + n / 32 + 1);
+			shift_left_limbs(&a[0], a.size(), n, &r[0]);
+			assign_limbs(&r[0], &r[0] + r.size(), !positive);
+		}
+
+		void shift_left_bits(int n, std::false_type) {
+			*this *= Integer(2).pow(n);
+		}
+
+		void shift_left_bits(int n) {
+			if (n >= shift_pass_limit()) {
+				shift_left_bits(n, is_binary_radix<R>());
+				return;
+			}
+			for (; n > 0; n -= SHIFT_PASS_BITS)
+				*this *= 1ULL << (n < SHIFT_PASS_BITS ? n : SHIFT_PASS_BITS);
+		}
+
+		// Negative values round toward negative infinity, as in two's
+		// complement
+		bool shift_right_bits(int n, std::true_type) {
+			const std::vector<unsigned> a = magnitude_limbs();
+			const std::size_t words = n / 32;
+			if (words >= a.size())
+				return shift_out();
+			std::vector<unsigned> r(a.size() - words);
+			const bool lost = shift_right_limbs(&a[0], a.size(), n, &r[0]);
+			assign_limbs(&r[0], &r[0] + r.size(), !positive);
+			return lost;
+		}
+
+		bool shift_right_bits(int n, std::false_type) {
+			// Each digit holds less than 64 bits
+			if (static_cast<std::size_t>(n) / 64 >= data.size())
+				return shift_out();
+			Integer remainder = 0;
+			divmod(Integer(2).pow(n), remainder);
+			return !remainder.is_zero();
+		}
+
+		void shift_right_bits(int n) {
+			const bool negative = !positive;
+			bool lost = false;
+			if (n >= shift_pass_limit())
+				lost = shift_right_bits(n, is_binary_radix<R>());
+			else {
+				for (; n > 0; n -= SHIFT_PASS_BITS) {
+					const int bits = n < SHIFT_PASS_BITS ? n : SHIFT_PASS_BITS;
+					lost = divides_digit(data.begin(), data.end(), 1ULL << bits, data.begin(), R()) != 0 || lost;
+					data.erase(data.begin(), strip_zeroes(data.begin(), std::prev(data.end())));
+				}
+				positive = positive || is_zero();
+			}
+			if (negative && lost)
+				*this -= 1;
+			assert(valid());
+		}
+
+		/**
+		 * Sets this Integer to 0 for a shift past all of its bits, for
+		 * shift_right_bits to round down to -1 if it was negative
+		 * @return true unless this Integer was already 0
+		 */
+		bool shift_out() {
+			const bool lost = !is_zero();
+			data.assign(1, 0);
+			positive = true;
+			return lost;
+		}
+
+		// Decimal shifts move digits when they are stored in base 10,
+		// any other radix has to multiply or divide by a power of ten
+		void shift_left_decimal(int n, decimal_radix) {
+			while (n-- > 0)
+				data.push_back(0);
+		}
+
+		template<typename R2>
+		void shift_left_decimal(int n, R2) {
+			if (n > 0)
+				*this *= Integer(10).pow(n);
+		}
 
-	private:
+		void shift_right_decimal(int n, decimal_radix) {
+			if (data.size() <= static_cast<unsigned int>(n)) {
+				data.clear();
+				data.push_back(0);
+				positive = true;
+			}
+			else {
+				data.erase(data.end() - n, data.end());
+			}
+		}
 
-		bool valid() const {
-			bool result = true;
-			result &= (data.size() > 0);
-			for (C_const_iter i = data.begin(); i != data.end(); ++i)
-				result &= (*i >= 0 && *i <= 9);
-			return result;
+		template<typename R2>
+		void shift_right_decimal(int n, R2) {
+			if (n > 0)
+				*this /= Integer(10).pow(n);
 		}
 
 	public:
@@ -771,13 +5795,13 @@ class Integer {
 		 */
 		Integer(int value) :
 				positive(value >= 0) {
-			value = std::abs(value);
-			if (value == 0)
+			wide_type magnitude = static_cast<wide_type>(std::abs(static_cast<long long>(value)));
+			if (magnitude == 0)
 				data.push_back(0);
 			else {
-				while (value > 0) {
-					data.push_back(value % 10);
-					value /= 10;
+				while (magnitude > 0) {
+					data.push_back(magnitude % R::base());
+					magnitude /= R::base();
 				}
 				std::reverse(data.begin(), data.end());
 			}
@@ -787,31 +5811,93 @@ class Integer {
 		/**
 		 * Constructs a new Integer object using a valid string
 		 *
-		 * @throws invalid_argument if value is not a valid representation of an Integer
+		 * @throws parse_error if value is not a valid representation of an Integer
 		 */
 		explicit Integer(const std::string& value) :
-				positive(value[0] != '-') {
-			int startIndex;
-			if (positive)
-				startIndex = 0;
-			else
-				startIndex = 1;
+				positive(true) {
+			parse(value.data(), value.data() + value.size());
+		}
+
+		/**
+		 * Constructs a new Integer object from the characters [first, last)
+		 * without copying them
+		 *
+		 * @throws parse_error if [first, last) is not a valid representation of an Integer
+		 */
+		Integer(const char* first, const char* last) :
+				positive(true) {
+			parse(first, last);
+		}
+
+		/**
+		 * Constructs a new Integer with the value of an expression
+		 */
+		template<typename E>
+		Integer(const integer_expression<Integer, E>& e) :
+				data(1, 0),
+				positive(true) {
+			scratch s;
+			e.self().accumulate_into(*this, false, s);
+		}
+
+		/**
+		 * Stores the value of an expression in this Integer
+		 * Evaluates into a copy first when the expression reads this Integer
+		 */
+		template<typename E>
+		Integer& operator =(const integer_expression<Integer, E>& e) {
+			if (e.self().aliases(*this)) {
+				Integer result(e);
+				data.swap(result.data);
+				positive = result.positive;
+				return *this;
+			}
+			data.assign(1, 0);
+			positive = true;
+			scratch s;
+			e.self().accumulate_into(*this, false, s);
+			return *this;
+		}
 
-			for (std::string::const_iterator i = value.begin() + startIndex; i != value.end(); ++i)
-				data.push_back(*i - '0');
+		/**
+		 * Adds the value of an expression to this Integer
+		 */
+		template<typename E>
+		Integer& operator +=(const integer_expression<Integer, E>& e) {
+			if (e.self().aliases(*this))
+				return *this += Integer(e);
+			scratch s;
+			e.self().accumulate_into(*this, false, s);
+			return *this;
+		}
 
-			if (!valid())
-				throw std::invalid_argument("Integer::Integer()");
+		/**
+		 * Subtracts the value of an expression from this Integer
+		 */
+		template<typename E>
+		Integer& operator -=(const integer_expression<Integer, E>& e) {
+			if (e.self().aliases(*this))
+				return *this -= Integer(e);
+			scratch s;
+			e.self().accumulate_into(*this, true, s);
+			return *this;
 		}
 
 		/**
 		 * Returns a new Integer with the negated value of this Integer
 		 */
-		Integer operator -() const {
+		Integer operator -() const& {
 			Integer result(*this);
-			result.positive = !positive;
-			assert(result.valid());
-			return result;
+			return -std::move(result);
+		}
+
+		/**
+		 * Negates an expiring Integer in place
+		 */
+		Integer operator -() && {
+			positive = !positive || is_zero();
+			assert(valid());
+			return std::move(*this);
 		}
 
 		/**
@@ -854,46 +5940,7 @@ class Integer {
 		 * @param rhs an Integer object
 		 */
 		Integer& operator +=(const Integer& rhs) {
-			// Adding 0
-			if (rhs == 0)
-				return *this;
-			if (*this == 0)
-				return *this = rhs;
-
-			C_diff_t bufferSize = std::max(data.size(), rhs.data.size()) + 1;
-			C buffer(bufferSize);
-			C_iter endOfNumber;
-			if (positive == rhs.positive) {
-				endOfNumber = plus_digits(data.begin(), data.end(), rhs.data.begin(), rhs.data.end(), buffer.begin());
-			}
-			else {
-				int cmp = compare(data.begin(), data.end(), rhs.data.begin(), rhs.data.end());
-				if (positive) {
-					assert(!rhs.positive);
-					if (cmp < 0) {
-						endOfNumber = minus_digits(rhs.data.begin(), rhs.data.end(), data.begin(), data.end(), buffer.begin());
-						positive = false;
-					}
-					else {
-						assert(cmp >= 0);
-						endOfNumber = minus_digits(data.begin(), data.end(), rhs.data.begin(), rhs.data.end(), buffer.begin());
-					}
-				}
-				else {
-					assert(!positive);
-					if (cmp > 0) {
-						endOfNumber = minus_digits(data.begin(), data.end(), rhs.data.begin(), rhs.data.end(), buffer.begin());
-					}
-					else {
-						assert(cmp <= 0);
-						endOfNumber = minus_digits(rhs.data.begin(), rhs.data.end(), data.begin(), data.end(), buffer.begin());
-						positive = true;
-					}
-				}
-			}
-
-			data.assign(buffer.begin(), endOfNumber);
-			assert(valid());
+			accumulate(rhs.data.begin(), rhs.data.end(), !rhs.positive);
 			return *this;
 		}
 
@@ -903,7 +5950,33 @@ class Integer {
 		 * @param rhs an Integer object
 		 */
 		Integer& operator -=(const Integer& rhs) {
-			return *this += -rhs;
+			accumulate(rhs.data.begin(), rhs.data.end(), rhs.positive);
+			return *this;
+		}
+
+		/**
+		 * Adds an expiring rhs, keeping whichever storage is longer
+		 */
+		Integer& operator +=(Integer&& rhs) {
+			if (data.size() < rhs.data.size()) {
+				data.swap(rhs.data);
+				std::swap(positive, rhs.positive);
+			}
+			return *this += rhs;
+		}
+
+		/**
+		 * Subtracts an expiring rhs, keeping whichever storage is longer
+		 */
+		Integer& operator -=(Integer&& rhs) {
+			if (data.size() < rhs.data.size()) {
+				data.swap(rhs.data);
+				std::swap(positive, rhs.positive);
+				*this -= rhs;
+				positive = !positive || is_zero();
+				return *this;
+			}
+			return *this -= rhs;
 		}
 
 		/**
@@ -912,35 +5985,31 @@ class Integer {
 		 * @param rhs an Integer object
 		 */
 		Integer& operator *=(const Integer& rhs) {
+			if (&rhs == this)
+				return square();
 			// Multiply by 0
-			if (*this == 0)
+			if (is_zero())
 				return *this;
-			if (rhs == 0) {
-				*this = 0;
+			if (rhs.is_zero()) {
+				data.assign(1, 0);
+				positive = true;
 				return *this;
 			}
-			// Multiply by 1
-			if (rhs == 1)
-				return *this;
-			if (*this == 1) {
-				*this = rhs;
-				return *this;
-			}
-
-			// Multiply by -1
-			if (*this == -1) {
-				*this = -rhs;
+			// Multiply by 1 or -1
+			if (rhs.is_unit()) {
+				positive = positive == rhs.positive;
 				return *this;
 			}
-			if (rhs == -1) {
-				positive = !positive;
+			if (is_unit()) {
+				data = rhs.data;
+				positive = positive == rhs.positive;
 				return *this;
 			}
 
-			C_diff_t bufferSize = data.size() + rhs.data.size();
-			C buffer(bufferSize);
-			C_iter endOfNumber = multiplies_digits(data.begin(), data.end(), rhs.data.begin(), rhs.data.end(), buffer.begin());
-			data.assign(buffer.begin(), endOfNumber);
+			C buffer(data.size() + rhs.data.size());
+			C_iter endOfNumber = multiplies_digits(data.begin(), data.end(), rhs.data.begin(), rhs.data.end(), buffer.begin(), R());
+			buffer.erase(endOfNumber, buffer.end());
+			data.swap(buffer);
 			positive = positive == rhs.positive;
 
 			assert(valid());
@@ -955,13 +6024,8 @@ class Integer {
 		 * @throws invalid_argument if (rhs == 0)
 		 */
 		Integer& operator /=(const Integer& rhs) {
-			C buffer(data.size(), 0);
-			C_iter endOfNumber = divides_digits(data.begin(), data.end(), rhs.data.begin(), rhs.data.end(), buffer.begin());
-			data.assign(buffer.begin(), endOfNumber);
-			positive = positive == rhs.positive;
-
-			assert(valid());
-			return *this;
+			Integer remainder = 0;
+			return divmod(rhs, remainder);
 		}
 
 		/**
@@ -973,39 +6037,296 @@ class Integer {
 		 * @throws invalid_argument if (rhs <= 0)
 		 */
 		Integer& operator %=(const Integer& rhs) {
-			Integer lowerValue = *this;
-			lowerValue /= rhs;
-			lowerValue *= rhs;
-			return *this -= lowerValue;
+			Integer remainder = 0;
+			divmod(rhs, remainder);
+			data.swap(remainder.data);
+			positive = remainder.positive;
+			return *this;
 		}
 
 		/**
-		 * Shifts the value in this Integer left by n digits, filling in 0's
+		 * Divides the value of this Integer by the value in rhs, which is
+		 * known to divide it, from the low digits up with nothing to estimate
+		 * or correct; debug builds check that the division is exact
+		 *
+		 * @param rhs an Integer object
+		 *
+		 * @throws invalid_argument if (rhs == 0)
 		 */
-		Integer& operator <<=(int n) {
-			if (*this != 0) {
-				while (n-- > 0)
-					data.push_back(0);
+		Integer& divexact(const Integer& rhs) {
+			if (rhs.is_zero())
+				throw std::invalid_argument("Integer::divexact()");
+			C buffer(data.size(), 0);
+			C_iter endOfNumber = divides_exact_digits(data.begin(), data.end(), rhs.data.begin(), rhs.data.end(), buffer.begin(), R());
+			buffer.erase(endOfNumber, buffer.end());
+			data.swap(buffer);
+			positive = positive == rhs.positive || is_zero();
+
+			assert(valid());
+			return *this;
+		}
+
+		/**
+		 * Divides the value of this Integer by the value in rhs, leaving the
+		 * quotient in this Integer and the remainder in remainder, both out
+		 * of one division
+		 * The quotient is truncated like operator /= and the remainder takes
+		 * the sign of the dividend like operator %=
+		 *
+		 * @param rhs       an Integer object, may be remainder
+		 * @param remainder an Integer object other than this one
+		 *
+		 * @throws invalid_argument if (rhs == 0)
+		 */
+		Integer& divmod(const Integer& rhs, Integer& remainder) {
+			assert(&remainder != this);
+			if (rhs.is_zero())
+				throw std::invalid_argument("Integer::divmod()");
+			C quotient(data.size(), 0);
+			C rest(rhs.data.size(), 0);
+			const std::pair<C_iter, C_iter> ends = divides_digits(data.begin(), data.end(), rhs.data.begin(), rhs.data.end(), quotient.begin(), rest.begin(), R());
+			quotient.erase(ends.first, quotient.end());
+			rest.erase(ends.second, rest.end());
+
+			const bool dividendPositive = positive;
+			data.swap(quotient);
+			positive = positive == rhs.positive || is_zero();
+			remainder.data.swap(rest);
+			remainder.positive = dividendPositive || remainder.is_zero();
+
+			assert(valid());
+			assert(remainder.valid());
+			return *this;
+		}
+
+		/**
+		 * Adds a built-in integer to this Integer in place
+		 */
+		template<typename S>
+		typename std::enable_if<std::is_integral<S>::value, Integer&>::type operator +=(S rhs) {
+			accumulate_scalar(scalar_magnitude(rhs), scalar_negative(rhs, std::is_signed<S>()));
+			return *this;
+		}
+
+		/**
+		 * Subtracts a built-in integer from this Integer in place
+		 */
+		template<typename S>
+		typename std::enable_if<std::is_integral<S>::value, Integer&>::type operator -=(S rhs) {
+			accumulate_scalar(scalar_magnitude(rhs), !scalar_negative(rhs, std::is_signed<S>()));
+			return *this;
+		}
+
+		/**
+		 * Multiplies this Integer by a built-in integer in one pass over its
+		 * digits
+		 */
+		template<typename S>
+		typename std::enable_if<std::is_integral<S>::value, Integer&>::type operator *=(S rhs) {
+			const unsigned long long magnitude = scalar_magnitude(rhs);
+			if (!scalar_word(magnitude))
+				return *this *= scalar(rhs);
+			if (magnitude == 0) {
+				data.assign(1, 0);
+				positive = true;
+				return *this;
+			}
+
+			wide_type carry = 0;
+			for (C_iter i = data.end(); i != data.begin();) {
+				--i;
+				carry += static_cast<wide_type>(*i) * magnitude;
+				*i = carry % R::base();
+				carry /= R::base();
 			}
+			for (; carry != 0; carry /= R::base())
+				data.insert(data.begin(), static_cast<T>(carry % R::base()));
+			positive = positive != scalar_negative(rhs, std::is_signed<S>()) || is_zero();
+
+			assert(valid());
+			return *this;
+		}
+
+		/**
+		 * Divides this Integer by a built-in integer in one pass over its
+		 * digits
+		 *
+		 * @throws invalid_argument if (rhs == 0)
+		 */
+		template<typename S>
+		typename std::enable_if<std::is_integral<S>::value, Integer&>::type operator /=(S rhs) {
+			if (rhs == 0)
+				throw std::invalid_argument("Integer::operator/=()");
+			const unsigned long long magnitude = scalar_magnitude(rhs);
+			if (!scalar_word(magnitude))
+				return *this /= scalar(rhs);
+
+			divides_digit(data.begin(), data.end(), magnitude, data.begin(), R());
+			data.erase(data.begin(), strip_zeroes(data.begin(), std::prev(data.end())));
+			positive = positive != scalar_negative(rhs, std::is_signed<S>()) || is_zero();
+
+			assert(valid());
+			return *this;
+		}
+
+		/**
+		 * Leaves the remainder of this Integer divided by a built-in integer,
+		 * with the sign of this Integer like operator %=, in one pass over its
+		 * digits
+		 *
+		 * @throws invalid_argument if (rhs == 0)
+		 */
+		template<typename S>
+		typename std::enable_if<std::is_integral<S>::value, Integer&>::type operator %=(S rhs) {
+			if (rhs == 0)
+				throw std::invalid_argument("Integer::operator%=()");
+			const unsigned long long magnitude = scalar_magnitude(rhs);
+			if (!scalar_word(magnitude))
+				return *this %= scalar(rhs);
+
+			const wide_type remainder = divides_digit(data.begin(), data.end(), magnitude, discard_iterator(), R());
+			T digits[SCALAR_DIGITS];
+			data.assign(digits, digits + scalar_digits(remainder, digits));
+			positive = positive || is_zero();
+
+			assert(valid());
+			return *this;
+		}
+
+		/**
+		 * Shifts the value in this Integer left by n decimal digits, filling
+		 * in 0's
+		 */
+		Integer& shift_left_decimal(int n) {
+			if (!is_zero())
+				shift_left_decimal(n, R());
 			return *this;
 		}
 
 		/**
-		 * Shifts the value in this Integer right by n digits
+		 * Shifts the value in this Integer right by n decimal digits
 		 * If shifted past the end of the Integer, this Integer will be set to
 		 * positive 0
 		 */
+		Integer& shift_right_decimal(int n) {
+			shift_right_decimal(n, R());
+			return *this;
+		}
+
+		/**
+		 * Shifts the value in this Integer left by n bits, multiplying it by
+		 * 2^n
+		 *
+		 * @throws invalid_argument if (n < 0)
+		 */
+		Integer& operator <<=(int n) {
+			if (n < 0)
+				throw std::invalid_argument("Integer::operator<<=()");
+			if (!is_zero() && n > 0)
+				shift_left_bits(n);
+			return *this;
+		}
+
+		/**
+		 * Shifts the value in this Integer right by n bits, dividing it by
+		 * 2^n and rounding toward negative infinity like a two's complement
+		 * shift, so negative values end at -1
+		 *
+		 * @throws invalid_argument if (n < 0)
+		 */
 		Integer& operator >>=(int n) {
-			if (data.size() <= static_cast<unsigned int>(n)) {
-				data.clear();
-				data.push_back(0);
-			}
-			else {
-				data.erase(data.end() - n, data.end());
-			}
+			if (n < 0)
+				throw std::invalid_argument("Integer::operator>>=()");
+			if (!is_zero() && n > 0)
+				shift_right_bits(n);
 			return *this;
 		}
 
+		/**
+		 * Ands the bits of this Integer with those of rhs, in two's
+		 * complement
+		 */
+		Integer& operator &=(const Integer& rhs) {
+			return bitwise(rhs, std::bit_and<unsigned>());
+		}
+
+		/**
+		 * Ors the bits of this Integer with those of rhs, in two's complement
+		 */
+		Integer& operator |=(const Integer& rhs) {
+			return bitwise(rhs, std::bit_or<unsigned>());
+		}
+
+		/**
+		 * Exclusive ors the bits of this Integer with those of rhs, in two's
+		 * complement
+		 */
+		Integer& operator ^=(const Integer& rhs) {
+			return bitwise(rhs, std::bit_xor<unsigned>());
+		}
+
+		/**
+		 * Returns a new Integer with every bit of this Integer flipped in
+		 * two's complement, -x - 1
+		 */
+		Integer operator ~() const {
+			Integer result = -*this;
+			result -= 1;
+			return result;
+		}
+
+		/**
+		 * Returns the number of bits in the magnitude, 0 for 0
+		 */
+		std::size_t bit_length() const {
+			const std::vector<unsigned> a = magnitude_limbs();
+			if (a.empty())
+				return 0;
+			std::size_t length = 32 * (a.size() - 1);
+			for (unsigned top = a.back(); top != 0; top >>= 1)
+				++length;
+			return length;
+		}
+
+		/**
+		 * Returns the number of 1 bits in the magnitude
+		 */
+		std::size_t popcount() const {
+			const std::vector<unsigned> a = magnitude_limbs();
+			std::size_t count = 0;
+			for (std::size_t i = 0; i < a.size(); ++i) {
+				for (unsigned limb = a[i]; limb != 0; limb &= limb - 1)
+					++count;
+			}
+			return count;
+		}
+
+		/**
+		 * Returns the index of the lowest 1 bit, the same for x and -x
+		 *
+		 * @throws invalid_argument if (this == 0)
+		 */
+		std::size_t lowest_set_bit() const {
+			if (is_zero())
+				throw std::invalid_argument("Integer::lowest_set_bit()");
+			const std::vector<unsigned> a = magnitude_limbs();
+			return lowest_set_bit_limbs(&a[0], a.size());
+		}
+
+		/**
+		 * Returns bit n of this Integer in two's complement
+		 * -m is ~m + 1, so below the lowest 1 bit of m the bits of -m are 0,
+		 * that bit is 1 and the bits above it are flipped
+		 */
+		bool test_bit(std::size_t n) const {
+			const std::vector<unsigned> a = magnitude_limbs();
+			const bool bit = n / 32 < a.size() && ((a[n / 32] >> (n % 32)) & 1) != 0;
+			if (positive)
+				return bit;
+			const std::size_t lowest = lowest_set_bit_limbs(&a[0], a.size());
+			return n == lowest || (n > lowest && !bit);
+		}
+
 		/**
 		 * Stores the absolute value of this Integer back into this Integer
 		 */
@@ -1014,6 +6335,142 @@ class Integer {
 			return *this;
 		}
 
+		/**
+		 * Squares the value of this Integer, working out each cross product
+		 * of its digits once
+		 */
+		Integer& square() {
+			positive = true;
+			if (is_zero() || is_unit())
+				return *this;
+
+			C buffer(2 * data.size());
+			C_iter endOfNumber = square_digits(data.begin(), data.end(), buffer.begin(), R());
+			buffer.erase(endOfNumber, buffer.end());
+			data.swap(buffer);
+
+			assert(valid());
+			return *this;
+		}
+
+		/**
+		 * Sets the value of this Integer to the greatest common divisor of
+		 * its value and y (Lehmer)
+		 */
+		Integer& gcd(const Integer& y) {
+			*this = gcd_cofactor(y, 0);
+			return *this;
+		}
+
+		/**
+		 * Sets the value of this Integer to its inverse mod m, in [0, m)
+		 *
+		 * @throws invalid_argument if (m <= 0) or the value and m share a factor
+		 */
+		Integer& mod_inverse(const Integer& m) {
+			if (!m.positive || m.is_zero())
+				throw std::invalid_argument("Integer::mod_inverse()");
+			Integer s = 0;
+			if (!gcd_cofactor(m, &s).is_unit())
+				throw std::invalid_argument("Integer::mod_inverse()");
+			if (!positive)
+				s = -std::move(s);
+			if (!(s %= m).positive)
+				s += m;
+			*this = s;
+			return *this;
+		}
+
+		/**
+		 * Reduces Integers by one modulus m, to the same values operator %=
+		 * leaves, with the reciprocal of m worked out once (Barrett), so each
+		 * reduction costs two products and a correction, not a long division
+		 */
+		class reducer {
+			private:
+				std::vector<T> modulus;
+				std::vector<T> reciprocal;
+
+			public:
+				/**
+				 * @throws invalid_argument if (m <= 0)
+				 */
+				explicit reducer(const Integer& m) {
+					if (!m.positive || m.is_zero())
+						throw std::invalid_argument("Integer::reducer()");
+					modulus.assign(m.data.rbegin(), m.data.rend());
+					reciprocal.resize(modulus.size() + 2);
+					barrett_form<T, R>::reciprocal(&modulus[0], modulus.size(), &reciprocal[0], default_workspace());
+				}
+
+				/**
+				 * x %= m
+				 */
+				Integer& reduce(Integer& x) const {
+					typedef typename std::iterator_traits<C_iter>::iterator_category iCat;
+					typedef std::reverse_iterator<T*> result_list_iterator;
+
+					// Fewer digits than m is already reduced
+					const std::size_t n = modulus.size();
+					if (x.data.size() < n)
+						return x;
+
+					workspace& w = default_workspace();
+					workspace::frame frame(w);
+					T* limbs;
+					const std::size_t length = copy_limbs(x.data.begin(), x.data.end(), limbs, w, iCat());
+					T* const r = w.allocate<T>(n);
+					const barrett_form<T, R> form(&modulus[0], n, &reciprocal[0]);
+					form.reduce(limbs, length, r, w);
+
+					x.data.erase(print_list(result_list_iterator(r + n), result_list_iterator(r), x.data.begin()), x.data.end());
+					x.positive = x.positive || x.is_zero();
+					assert(x.valid());
+					return x;
+				}
+
+				/**
+				 * Reduces every Integer in [b, e) in place
+				 */
+				template<typename FI>
+				void reduce(FI b, FI e) const {
+					while (b != e)
+						reduce(*b++);
+				}
+		};
+
+		/**
+		 * Raises the value of this Integer to the e power mod m, leaving it
+		 * in [0, m), without building the power
+		 * An odd m goes through Montgomery form and the exponent through
+		 * sliding windows
+		 *
+		 * @throws invalid_argument if (e < 0) or (m <= 0)
+		 */
+		Integer& powmod(const Integer& e, const Integer& m) {
+			if (!e.positive || !m.positive || m.is_zero())
+				throw std::invalid_argument("Integer::powmod()");
+
+			C buffer(m.data.size());
+			C_iter endOfNumber = powmod_digits(data.begin(), data.end(), e.data.begin(), e.data.end(), m.data.begin(), m.data.end(), buffer.begin(), R());
+			buffer.erase(endOfNumber, buffer.end());
+
+			// An odd power of a negative value is m less the power of its magnitude
+			if (!positive && (*std::prev(e.data.end()) & 1) != 0) {
+				Integer difference = m;
+				data.swap(buffer);
+				positive = true;
+				if (!is_zero())
+					*this = difference -= *this;
+				return *this;
+			}
+			data.swap(buffer);
+			positive = true;
+
+			assert(valid());
+			return *this;
+		}
+
 		/**
 		 * power
 		 *
@@ -1023,23 +6480,25 @@ class Integer {
 		 * @throws invalid_argument if (e < 0)
 		 */
 		Integer& pow(int e) {
-			if ((*this == 0 && e == 0) || e < 0)
+			if ((is_zero() && e == 0) || e < 0)
 				throw std::invalid_argument("Integer::pow()");
-			if (*this == 1 || *this == 0)
+			if ((is_unit() && positive) || is_zero())
 				return *this;
 			if (e == 0) {
-				*this = 1;
+				data.assign(1, 1);
+				positive = true;
 				return *this;
 			}
 
 			// Learned this trick from Java's BigInteger
 			Integer originalValue = *this;
-			*this = 1;
+			data.assign(1, 1);
+			positive = true;
 			while (e != 0) {
 				if ((e & 1) == 1)
 					*this *= originalValue;
 				if ((e >>= 1) != 0)
-					originalValue *= originalValue;
+					originalValue.square();
 			}
 			return *this;
 		}
@@ -6,7 +6,7 @@
 
 /*
 To run the program:
-    % g++ -pedantic -std=c++0x -Wall Integer.c++ RunInteger.c++ -o RunInteger
+    % g++ -pedantic -std=c++0x -Wall -pthread Integer.c++ RunInteger.c++ -o RunInteger
     % valgrind RunInteger > RunInteger.out
 
 To configure Doxygen:
@@ -53,6 +53,9 @@ int main () {
     cout << "2^4423 - 1 = " << n << endl << endl;
     }
 
+    // Lucas-Lehmer, 4421 squares mod 2^4423 - 1
+    cout << "2^4423 - 1 is " << (lucas_lehmer(4423) ? "prime" : "composite") << endl << endl;
+
     // --------------------------
     // extra credit (5 bonus pts)
     // --------------------------
@@ -66,16 +69,16 @@ int main () {
     cout << "2^132049 - 1 = " << n << endl << endl;
     }
 
-    cout << "Done." << endl;
+    // Crazy
+    // less than 10 s without valgrind, the products go through the NTT
+    // don't run with valgrind
+    cout << "*** 42th Mersenne prime: 7,816,230 digits ***" << endl << endl;
 
+    {
+    const Integer<int> n = Integer<int>(2).pow(25964951) - 1;
+    cout << "2^25964951 - 1 = " << n << endl << endl;
+    }
 
-//    {
-//    // Crazy
-//    cout << endl << "*** 42th Mersenne prime: 7,816,230 digits ***" << endl << endl;
-//    const Integer<int> n = Integer<int>(2).pow(25964951) - 1;
-//    cout << "2^132049 - 1 = " << n << endl << endl;
-//    }
-//
-//    cout << "Done." << endl;
+    cout << "Done." << endl;
 
     return 0;}
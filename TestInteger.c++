@@ -12,7 +12,7 @@ To test the program:
     ...
     % locate libcppunit.a
     /usr/lib/libcppunit.a
-    % g++ -pedantic -std=c++0x -Wall Integer.c++ TestInteger.c++ -o TestInteger -lcppunit -ldl
+    % g++ -pedantic -std=c++0x -Wall -pthread Integer.c++ TestInteger.c++ -o TestInteger -lcppunit -ldl
     % valgrind TestInteger > TestInteger.out
 */
 
@@ -20,11 +20,14 @@ To test the program:
 // includes
 // --------
 
-#include <algorithm> // equal
+#include <algorithm> // count, equal
 #include <cstring>   // strcmp
+#include <deque>     // deque
 #include <sstream>   // ostringstream
 #include <stdexcept> // invalid_argument
 #include <string>    // ==
+#include <type_traits> // is_nothrow_move_assignable, is_nothrow_move_constructible
+#include <vector>    // vector
 
 #include "cppunit/extensions/HelperMacros.h" // CPPUNIT_TEST, CPPUNIT_TEST_SUITE, CPPUNIT_TEST_SUITE_END
 #include "cppunit/TestFixture.h"             // TestFixture
@@ -133,6 +136,22 @@ struct TestInteger : CppUnit::TestFixture {
         CPPUNIT_ASSERT(c == -1);
     }
 
+    // Long enough for the registers, at every level this processor has
+    void test_compare_06 () {
+        std::vector<int> a(100, 3);
+        std::vector<int> b(103, 3);
+        b[0] = b[1] = b[2] = 0;
+        a[99] = 4;
+        const simd_level level = simd_support();
+        for (int i = SIMD_NONE; i <= level; ++i) {
+            simd_support() = static_cast<simd_level>(i);
+            CPPUNIT_ASSERT(compare(&a[0], &a[0] + 100, &b[0], &b[0] + 103) == 1);
+            CPPUNIT_ASSERT(compare(&b[0], &b[0] + 103, &a[0], &a[0] + 100) == -1);
+            CPPUNIT_ASSERT(strip_zeroes(&b[0], &b[0] + 103) == &b[3]);
+        }
+        simd_support() = level;
+    }
+
     // -----------------
     // shift_left_digits
     // -----------------
@@ -289,6 +308,54 @@ struct TestInteger : CppUnit::TestFixture {
         CPPUNIT_ASSERT(std::equal(const_cast<const int*>(x), p, c));
     }
 
+    // Binary limbs carry at 2^32
+    void test_plus_digits_06 () {
+        const unsigned a[] = {1, 4294967295u};
+        const unsigned b[] = {1};
+        const unsigned c[] = {2, 0};
+        unsigned x[10];
+        const unsigned* p = plus_digits(a, a + 2, b, b + 1, x, binary32_radix());
+        CPPUNIT_ASSERT(p - x == 2);
+        CPPUNIT_ASSERT(std::equal(const_cast<const unsigned*>(x), p, c));
+    }
+
+    // In place, the carry runs through every digit
+    void test_plus_digits_07 () {
+        int a[] = {9, 9, 9, 0, 0};
+        const int b[] = {1};
+        const int c[] = {1, 0, 0, 0};
+        int* p = plus_digits(a, a + 3, b, b + 1, a);
+        CPPUNIT_ASSERT(p - a == 4);
+        CPPUNIT_ASSERT(std::equal(a, p, c));
+    }
+
+    // The carry runs through every register, at every level this processor has
+    void test_plus_digits_09 () {
+        std::vector<int> a(50, 9);
+        const int b[] = {1};
+        const simd_level level = simd_support();
+        for (int i = SIMD_NONE; i <= level; ++i) {
+            simd_support() = static_cast<simd_level>(i);
+            std::vector<int> x(51, 7);
+            std::vector<int>::iterator p = plus_digits(a.begin(), a.end(), b, b + 1, x.begin());
+            CPPUNIT_ASSERT(p == x.end());
+            CPPUNIT_ASSERT(x[0] == 1);
+            CPPUNIT_ASSERT(std::count(x.begin(), x.end(), 0) == 50);
+        }
+        simd_support() = level;
+    }
+
+    // In place into the shorter operand, no carry out of a run of nines
+    void test_plus_digits_08 () {
+        const int a[] = {1, 9, 9, 8};
+        std::vector<int> b(5);
+        b[0] = 1;
+        const int c[] = {1, 9, 9, 9};
+        std::vector<int>::iterator p = plus_digits(a, a + 4, b.begin(), b.begin() + 1, b.begin());
+        CPPUNIT_ASSERT(p - b.begin() == 4);
+        CPPUNIT_ASSERT(std::equal(b.begin(), p, c));
+    }
+
     // ------------
     // minus_digits
     // ------------
@@ -342,6 +409,42 @@ struct TestInteger : CppUnit::TestFixture {
         CPPUNIT_ASSERT(std::equal(const_cast<const int*>(x), p, c));
     }
 
+    void test_minus_digits_05 () {
+        const unsigned a[] = {1, 0, 0};
+        const unsigned b[] = {1};
+        const unsigned c[] = {4294967295u, 4294967295u};
+        unsigned x[10];
+        const unsigned* p = minus_digits(a, a + 3, b, b + 1, x, binary32_radix());
+        CPPUNIT_ASSERT(p - x == 2);
+        CPPUNIT_ASSERT(std::equal(const_cast<const unsigned*>(x), p, c));
+    }
+
+    // The borrow runs through every register, at every level this processor has
+    void test_minus_digits_07 () {
+        unsigned a[41] = {1};
+        unsigned b[40] = {};
+        b[39] = 1;
+        const simd_level level = simd_support();
+        for (int i = SIMD_NONE; i <= level; ++i) {
+            simd_support() = static_cast<simd_level>(i);
+            unsigned x[41];
+            unsigned* p = minus_digits(a, a + 41, b, b + 40, x, decimal9_radix());
+            CPPUNIT_ASSERT(p - x == 40);
+            CPPUNIT_ASSERT(std::count(x, p, 999999999u) == 40);
+        }
+        simd_support() = level;
+    }
+
+    // In place, the top digits cancel
+    void test_minus_digits_06 () {
+        int a[] = {1, 0, 0, 0};
+        const int b[] = {9, 9, 9};
+        const int c[] = {1};
+        int* p = minus_digits(a, a + 4, b, b + 3, a);
+        CPPUNIT_ASSERT(p - a == 1);
+        CPPUNIT_ASSERT(std::equal(a, p, c));
+    }
+
     // -----------------
     // multiplies_digits
     // -----------------
@@ -405,6 +508,304 @@ struct TestInteger : CppUnit::TestFixture {
         CPPUNIT_ASSERT(std::equal(const_cast<const int*>(x), p, c));
     }
 
+    // (2^32 - 1)^2 = 2^64 - 2^33 + 1
+    void test_multiplies_digits_06 () {
+        const unsigned a[] = {4294967295u};
+        const unsigned c[] = {4294967294u, 1};
+        unsigned x[10];
+        const unsigned* p = multiplies_digits(a, a + 1, a, a + 1, x, binary32_radix());
+        CPPUNIT_ASSERT(p - x == 2);
+        CPPUNIT_ASSERT(std::equal(const_cast<const unsigned*>(x), p, c));
+    }
+
+    // Karatsuba against the schoolbook kernel
+    void test_multiplies_digits_07 () {
+        std::vector<int> a(300);
+        std::vector<int> b(170);
+        for (std::size_t i = 0; i < a.size(); ++i)
+            a[i] = (i * 7 + 3) % 10;
+        for (std::size_t i = 0; i < b.size(); ++i)
+            b[i] = (i * 3 + 1) % 10;
+        std::vector<int> x(470);
+        std::vector<int> y(470);
+        const std::size_t threshold = karatsuba_threshold();
+        karatsuba_threshold() = 4;
+        std::vector<int>::iterator p = multiplies_digits(a.begin(), a.end(), b.begin(), b.end(), x.begin());
+        karatsuba_threshold() = 1000;
+        std::vector<int>::iterator q = multiplies_digits(a.begin(), a.end(), b.begin(), b.end(), y.begin());
+        karatsuba_threshold() = threshold;
+        CPPUNIT_ASSERT(p - x.begin() == 469);
+        CPPUNIT_ASSERT(q - y.begin() == 469);
+        CPPUNIT_ASSERT(std::equal(x.begin(), p, y.begin()));
+    }
+
+    void test_multiplies_digits_08 () {
+        std::deque<unsigned> a(90, 4294967295u);
+        std::deque<unsigned> x(180);
+        std::deque<unsigned> y(180);
+        const std::size_t threshold = karatsuba_threshold();
+        karatsuba_threshold() = 5;
+        std::deque<unsigned>::iterator p = multiplies_digits(a.begin(), a.end(), a.begin(), a.end(), x.begin(), binary32_radix());
+        karatsuba_threshold() = 1000;
+        std::deque<unsigned>::iterator q = multiplies_digits(a.begin(), a.end(), a.begin(), a.end(), y.begin(), binary32_radix());
+        karatsuba_threshold() = threshold;
+        CPPUNIT_ASSERT(p - x.begin() == 180);
+        CPPUNIT_ASSERT(q - y.begin() == 180);
+        CPPUNIT_ASSERT(std::equal(x.begin(), p, y.begin()));
+        CPPUNIT_ASSERT(x[89] == 4294967294u && x[179] == 1);
+    }
+
+    // Toom-3 against the schoolbook kernel
+    void test_multiplies_digits_09 () {
+        std::vector<int> a(400);
+        std::vector<int> b(350);
+        for (std::size_t i = 0; i < a.size(); ++i)
+            a[i] = 9 - (i * i) % 10;
+        for (std::size_t i = 0; i < b.size(); ++i)
+            b[i] = (i * 13 + 5) % 10;
+        std::vector<int> x(750);
+        std::vector<int> y(750);
+        const std::size_t threshold = karatsuba_threshold();
+        const std::size_t toomThreshold = toom3_threshold();
+        karatsuba_threshold() = 4;
+        toom3_threshold() = 9;
+        std::vector<int>::iterator p = multiplies_digits(a.begin(), a.end(), b.begin(), b.end(), x.begin());
+        karatsuba_threshold() = 1000;
+        std::vector<int>::iterator q = multiplies_digits(a.begin(), a.end(), b.begin(), b.end(), y.begin());
+        karatsuba_threshold() = threshold;
+        toom3_threshold() = toomThreshold;
+        CPPUNIT_ASSERT(p - x.begin() == 750);
+        CPPUNIT_ASSERT(q - y.begin() == 750);
+        CPPUNIT_ASSERT(std::equal(x.begin(), p, y.begin()));
+    }
+
+    // NTT against the schoolbook kernel
+    void test_multiplies_digits_10 () {
+        std::vector<unsigned> a(120);
+        std::vector<unsigned> b(70);
+        for (std::size_t i = 0; i < a.size(); ++i)
+            a[i] = 4294967295u - i * 2654435761u;
+        for (std::size_t i = 0; i < b.size(); ++i)
+            b[i] = 4294967295u - i;
+        std::vector<unsigned> x(190);
+        std::vector<unsigned> y(190);
+        const std::size_t threshold = ntt_threshold();
+        ntt_threshold() = 1;
+        std::vector<unsigned>::iterator p = multiplies_digits(a.begin(), a.end(), b.begin(), b.end(), x.begin(), binary32_radix());
+        ntt_threshold() = threshold;
+        const std::size_t karatsuba = karatsuba_threshold();
+        karatsuba_threshold() = 1000;
+        std::vector<unsigned>::iterator q = multiplies_digits(a.begin(), a.end(), b.begin(), b.end(), y.begin(), binary32_radix());
+        karatsuba_threshold() = karatsuba;
+        CPPUNIT_ASSERT(p - x.begin() == 190);
+        CPPUNIT_ASSERT(q - y.begin() == 190);
+        CPPUNIT_ASSERT(std::equal(x.begin(), p, y.begin()));
+    }
+
+    void test_multiplies_digits_11 () {
+        std::vector<int> a(1000, 9);
+        std::vector<int> x(2000);
+        const std::size_t threshold = ntt_threshold();
+        ntt_threshold() = 1;
+        std::vector<int>::iterator p = multiplies_digits(a.begin(), a.end(), a.begin(), a.end(), x.begin());
+        ntt_threshold() = threshold;
+        // (10^1000 - 1)^2 = 99...9800...01
+        CPPUNIT_ASSERT(p - x.begin() == 2000);
+        CPPUNIT_ASSERT(std::count(x.begin(), x.begin() + 999, 9) == 999);
+        CPPUNIT_ASSERT(x[999] == 8);
+        CPPUNIT_ASSERT(std::count(x.begin() + 1000, x.begin() + 1999, 0) == 999);
+        CPPUNIT_ASSERT(x[1999] == 1);
+    }
+
+    // Karatsuba and Toom-3 with their subproducts on helper threads
+    void test_multiplies_digits_12 () {
+        std::vector<int> a(900);
+        std::vector<int> b(700);
+        for (std::size_t i = 0; i < a.size(); ++i)
+            a[i] = (i * 7 + 3) % 10;
+        for (std::size_t i = 0; i < b.size(); ++i)
+            b[i] = (i * 13 + 5) % 10;
+        std::vector<int> x(1600);
+        std::vector<int> y(1600);
+        const std::size_t threads = multiply_threads();
+        const std::size_t threshold = parallel_threshold();
+        const std::size_t karatsuba = karatsuba_threshold();
+        const std::size_t toom = toom3_threshold();
+        karatsuba_threshold() = 4;
+        toom3_threshold() = 30;
+        multiply_threads() = 4;
+        parallel_threshold() = 10;
+        std::vector<int>::iterator p = multiplies_digits(a.begin(), a.end(), b.begin(), b.end(), x.begin());
+        CPPUNIT_ASSERT(busy_threads() == 0);
+        multiply_threads() = 1;
+        karatsuba_threshold() = 1000;
+        std::vector<int>::iterator q = multiplies_digits(a.begin(), a.end(), b.begin(), b.end(), y.begin());
+        multiply_threads() = threads;
+        parallel_threshold() = threshold;
+        karatsuba_threshold() = karatsuba;
+        toom3_threshold() = toom;
+        CPPUNIT_ASSERT(p - x.begin() == 1600);
+        CPPUNIT_ASSERT(q - y.begin() == 1600);
+        CPPUNIT_ASSERT(std::equal(x.begin(), p, y.begin()));
+    }
+
+    // Long enough for the NTT butterflies to be shared out
+    void test_multiplies_digits_13 () {
+        std::vector<int> a(70000, 9);
+        std::vector<int> x(140000);
+        const std::size_t threads = multiply_threads();
+        multiply_threads() = 4;
+        std::vector<int>::iterator p = multiplies_digits(a.begin(), a.end(), a.begin(), a.end(), x.begin());
+        multiply_threads() = threads;
+        CPPUNIT_ASSERT(busy_threads() == 0);
+        // (10^70000 - 1)^2 = 99...9800...01
+        CPPUNIT_ASSERT(p - x.begin() == 140000);
+        CPPUNIT_ASSERT(std::count(x.begin(), x.begin() + 69999, 9) == 69999);
+        CPPUNIT_ASSERT(x[69999] == 8);
+        CPPUNIT_ASSERT(std::count(x.begin() + 70000, x.begin() + 139999, 0) == 69999);
+        CPPUNIT_ASSERT(x[139999] == 1);
+    }
+
+    // Pool workers outlive their forks, so a later fork finds the
+    // workspace an earlier one grew on the same worker; the tests above
+    // start at most three workers, so some of the eight forks share one
+    void test_thread_pool () {
+        const std::size_t threads = multiply_threads();
+        multiply_threads() = 2;
+        std::size_t warm = 0;
+        for (int i = 0; i < 8; ++i) {
+            task_group group(default_workspace(), true);
+            group.run([&] (workspace& w) {
+                warm += w.capacity() >= (1 << 20) * sizeof(unsigned);
+                workspace::frame f(w);
+                w.allocate<unsigned>(1 << 20);});
+            group.wait();
+        }
+        multiply_threads() = threads;
+        CPPUNIT_ASSERT(busy_threads() == 0);
+        CPPUNIT_ASSERT(warm > 0);
+    }
+
+    // Squares through every tier against products of a copy
+    void test_square_digits_01 () {
+        std::vector<unsigned> a(300);
+        for (std::size_t i = 0; i < a.size(); ++i)
+            a[i] = 4294967295u - i * 2654435761u;
+        const std::vector<unsigned> b(a);
+        const std::size_t karatsuba = karatsuba_threshold();
+        const std::size_t toom = toom3_threshold();
+        for (std::size_t n = 1; n <= a.size(); n += 23) {
+            std::vector<unsigned> x(2 * n);
+            std::vector<unsigned> y(2 * n);
+            karatsuba_threshold() = 4;
+            toom3_threshold() = 30;
+            std::vector<unsigned>::iterator p = square_digits(a.begin(), a.begin() + n, x.begin(), binary32_radix());
+            karatsuba_threshold() = 1000;
+            std::vector<unsigned>::iterator q = multiplies_digits(a.begin(), a.begin() + n, b.begin(), b.begin() + n, y.begin(), binary32_radix());
+            CPPUNIT_ASSERT(p - x.begin() == q - y.begin());
+            CPPUNIT_ASSERT(std::equal(x.begin(), p, y.begin()));
+        }
+        karatsuba_threshold() = karatsuba;
+        toom3_threshold() = toom;
+    }
+
+    void test_square_digits_02 () {
+        std::vector<int> a(1000, 9);
+        std::vector<int> x(2000);
+        const std::size_t threshold = ntt_threshold();
+        ntt_threshold() = 1;
+        std::vector<int>::iterator p = square_digits(a.begin(), a.end(), x.begin());
+        ntt_threshold() = threshold;
+        // (10^1000 - 1)^2 = 99...9800...01
+        CPPUNIT_ASSERT(p - x.begin() == 2000);
+        CPPUNIT_ASSERT(std::count(x.begin(), x.begin() + 999, 9) == 999);
+        CPPUNIT_ASSERT(x[999] == 8);
+        CPPUNIT_ASSERT(std::count(x.begin() + 1000, x.begin() + 1999, 0) == 999);
+        CPPUNIT_ASSERT(x[1999] == 1);
+    }
+
+    // The exponents of the first Mersenne primes
+    void test_lucas_lehmer_01 () {
+        const unsigned e[] = {2, 3, 5, 7, 13, 17, 19, 31, 61, 89, 107, 127, 521, 607};
+        const unsigned* const end = e + sizeof(e) / sizeof(e[0]);
+        for (unsigned p = 0; p <= 640; ++p)
+            CPPUNIT_ASSERT(lucas_lehmer(p) == (std::find(e, end, p) != end));
+    }
+
+    // Squares far enough up to take Karatsuba and Toom-3
+    void test_lucas_lehmer_02 () {
+        CPPUNIT_ASSERT(lucas_lehmer(4423));
+        CPPUNIT_ASSERT(!lucas_lehmer(4409));
+    }
+
+    void test_mersenne_reduce_limbs () {
+        // 2^40 - 1 mod 2^33 - 1 = 2^7 - 1 and (2^33 - 1)^2 mod 2^33 - 1 = 0
+        const unsigned x[] = {4294967295u, 255};
+        const unsigned y[] = {1, 4294967292u, 3};
+        unsigned r[] = {9, 9};
+        workspace w;
+        mersenne_reduce_limbs(x, 2, 33, r, w);
+        CPPUNIT_ASSERT(r[0] == 127 && r[1] == 0);
+        mersenne_reduce_limbs(y, 3, 33, r, w);
+        CPPUNIT_ASSERT(r[0] == 0 && r[1] == 0);
+    }
+
+    void test_powmod_digits_01 () {
+        const int a[] = {4};
+        const int e[] = {1, 3};
+        const int m[] = {4, 9, 7};
+        int x[10];
+        const int* p = powmod_digits(a, a + 1, e, e + 2, m, m + 3, x);
+        CPPUNIT_ASSERT(p - x == 3);
+        CPPUNIT_ASSERT(x[0] == 4 && x[1] == 4 && x[2] == 5);
+    }
+
+    // An even modulus has no Montgomery form
+    void test_powmod_digits_02 () {
+        const unsigned a[] = {3};
+        const unsigned e[] = {100};
+        const unsigned m[] = {1, 0, 0};
+        unsigned x[10];
+        const unsigned* p = powmod_digits(a, a + 1, e, e + 1, m, m + 3, x, binary32_radix());
+        // 3^100 mod 2^64 = 15462121228172006353
+        CPPUNIT_ASSERT(p - x == 2);
+        CPPUNIT_ASSERT(x[0] == 3600055637u && x[1] == 3476558801u);
+    }
+
+    void test_gcd_digits () {
+        const int a[] = {4, 6, 2};
+        const int b[] = {1, 0, 7, 1};
+        int x[10];
+        const int* p = gcd_digits(a, a + 3, b, b + 4, x);
+        CPPUNIT_ASSERT(p - x == 2);
+        CPPUNIT_ASSERT(x[0] == 2 && x[1] == 1);
+    }
+
+    void test_divides_exact_digits () {
+        const int a[] = {3, 9, 0, 6, 2, 5};
+        const int b[] = {1, 2, 5};
+        int x[10];
+        const int* p = divides_exact_digits(a, a + 6, b, b + 3, x);
+        CPPUNIT_ASSERT(p - x == 4);
+        CPPUNIT_ASSERT(x[0] == 3 && x[1] == 1 && x[2] == 2 && x[3] == 5);
+    }
+
+    void test_multiplies_digit () {
+        const int a[] = {9, 9, 9};
+        const int c[] = {0, 8, 9, 9, 1};
+        int x[10];
+        const int* p = multiplies_digit(a, a + 3, 9, x, decimal_radix());
+        CPPUNIT_ASSERT(((p - x) == 4) && "Keeps the leading digit even when it is 0");
+        CPPUNIT_ASSERT(std::equal(const_cast<const int*>(x), p, c + 1));
+    }
+
+    void test_divides_digit () {
+        const int a[] = {1, 2, 3, 4, 5};
+        int x[10];
+        CPPUNIT_ASSERT(divides_digit(a, a + 5, 7, x, decimal_radix()) == 4);
+        CPPUNIT_ASSERT(x[0] == 0 && x[1] == 1 && x[2] == 7 && x[3] == 6 && x[4] == 3);
+    }
+
     // --------------
     // divides_digits
     // --------------
@@ -559,6 +960,216 @@ struct TestInteger : CppUnit::TestFixture {
         CPPUNIT_ASSERT(std::equal(const_cast<const int*>(x), p, c));
     }
 
+    void test_divides_digits_15 () {
+        const unsigned a[] = {4294967294u, 1};
+        const unsigned b[] = {4294967295u};
+        unsigned x[10];
+        const unsigned* p = divides_digits(a, a + 2, b, b + 1, x, binary32_radix());
+        CPPUNIT_ASSERT(p - x == 1);
+        CPPUNIT_ASSERT(std::equal(const_cast<const unsigned*>(x), p, b));
+    }
+
+    void test_divides_digits_16 () {
+        const int a[] = {1, 4, 4};
+        const int b[] = {1, 1};
+        const int c[] = {1, 3};
+        const int d[] = {1};
+        int x[10];
+        int y[10];
+        std::pair<int*, int*> p = divides_digits(a, a + 3, b, b + 2, x, y, decimal_radix());
+        CPPUNIT_ASSERT(p.first - x == 2);
+        CPPUNIT_ASSERT(p.second - y == 1);
+        CPPUNIT_ASSERT(std::equal(x, p.first, c));
+        CPPUNIT_ASSERT(std::equal(y, p.second, d));
+    }
+
+    // Dividend shorter than the divisor leaves it all as the remainder
+    void test_divides_digits_17 () {
+        const int a[] = {0, 4, 2};
+        const int b[] = {1, 1, 1};
+        const int c[] = {0};
+        const int d[] = {4, 2};
+        int x[10];
+        int y[10];
+        std::pair<int*, int*> p = divides_digits(a, a + 3, b, b + 3, x, y, decimal_radix());
+        CPPUNIT_ASSERT(p.first - x == 1);
+        CPPUNIT_ASSERT(p.second - y == 2);
+        CPPUNIT_ASSERT(std::equal(x, p.first, c));
+        CPPUNIT_ASSERT(std::equal(y, p.second, d));
+    }
+
+    // (2^96 - 1) / (2^64 - 1) = 2^32 remainder 2^32 - 1
+    void test_divides_digits_18 () {
+        const unsigned a[] = {4294967295u, 4294967295u, 4294967295u};
+        const unsigned b[] = {4294967295u, 4294967295u};
+        const unsigned c[] = {1, 0};
+        const unsigned d[] = {4294967295u};
+        unsigned x[10];
+        unsigned y[10];
+        std::pair<unsigned*, unsigned*> p = divides_digits(a, a + 3, b, b + 2, x, y, binary32_radix());
+        CPPUNIT_ASSERT(p.first - x == 2);
+        CPPUNIT_ASSERT(p.second - y == 1);
+        CPPUNIT_ASSERT(std::equal(x, p.first, c));
+        CPPUNIT_ASSERT(std::equal(y, p.second, d));
+    }
+
+    // Burnikel-Ziegler recursion against Algorithm D alone
+    void test_divides_digits_19 () {
+        std::vector<unsigned> a(250);
+        std::vector<unsigned> b(90);
+        for (std::size_t i = 0; i < a.size(); ++i)
+            a[i] = 2654435761u * (i + 1);
+        for (std::size_t i = 0; i < b.size(); ++i)
+            b[i] = 4294967295u - 40503u * i;
+        std::vector<unsigned> q1(250);
+        std::vector<unsigned> r1(250);
+        std::vector<unsigned> q2(250);
+        std::vector<unsigned> r2(250);
+        const std::size_t threshold = burnikel_ziegler_threshold();
+        burnikel_ziegler_threshold() = 4;
+        std::pair<std::vector<unsigned>::iterator, std::vector<unsigned>::iterator> p =
+            divides_digits(a.begin(), a.end(), b.begin(), b.end(), q1.begin(), r1.begin(), binary32_radix());
+        burnikel_ziegler_threshold() = 1000;
+        std::pair<std::vector<unsigned>::iterator, std::vector<unsigned>::iterator> q =
+            divides_digits(a.begin(), a.end(), b.begin(), b.end(), q2.begin(), r2.begin(), binary32_radix());
+        burnikel_ziegler_threshold() = threshold;
+        CPPUNIT_ASSERT(p.first - q1.begin() == 160);
+        CPPUNIT_ASSERT(q.first - q2.begin() == 160);
+        CPPUNIT_ASSERT(p.second - r1.begin() == q.second - r2.begin());
+        CPPUNIT_ASSERT(std::equal(q1.begin(), p.first, q2.begin()));
+        CPPUNIT_ASSERT(std::equal(r1.begin(), p.second, r2.begin()));
+    }
+
+    // ----------------
+    // radix conversion
+    // ----------------
+
+    void test_radix_to_decimal () {
+        const unsigned a[] = {1, 0};
+        const int c[] = {4, 2, 9, 4, 9, 6, 7, 2, 9, 6};
+        int x[20];
+        const int* p = radix_to_decimal(a, a + 2, x, binary32_radix());
+        CPPUNIT_ASSERT(p - x == 10);
+        CPPUNIT_ASSERT(std::equal(const_cast<const int*>(x), p, c));
+    }
+
+    void test_radix_to_decimal_01 () {
+        const unsigned a[] = {0, 0};
+        const int c[] = {0};
+        int x[20];
+        const int* p = radix_to_decimal(a, a + 2, x, binary32_radix());
+        CPPUNIT_ASSERT(p - x == 1);
+        CPPUNIT_ASSERT(std::equal(const_cast<const int*>(x), p, c));
+    }
+
+    void test_decimal_to_radix () {
+        const int a[] = {0, 4, 2, 9, 4, 9, 6, 7, 2, 9, 7};
+        const unsigned c[] = {1, 1};
+        unsigned x[10];
+        const unsigned* p = decimal_to_radix(a, a + 11, x, binary32_radix());
+        CPPUNIT_ASSERT(p - x == 2);
+        CPPUNIT_ASSERT(std::equal(const_cast<const unsigned*>(x), p, c));
+    }
+
+    // ---------
+    // workspace
+    // ---------
+
+    // Closing a frame gives its scratch back for the next one
+    void test_workspace_01 () {
+        workspace w;
+        int* p;
+        {
+            workspace::frame f(w);
+            p = w.allocate<int>(100);
+            CPPUNIT_ASSERT(p[99] == 0);
+            p[0] = 5;
+        }
+        const std::size_t capacity = w.capacity();
+        {
+            workspace::frame f(w);
+            int* q = w.allocate<int>(100);
+            CPPUNIT_ASSERT(q == p);
+            CPPUNIT_ASSERT(q[0] == 0);
+        }
+        CPPUNIT_ASSERT(w.capacity() == capacity);
+    }
+
+    // Blocks already held are never moved, however large the next request
+    void test_workspace_02 () {
+        workspace w;
+        workspace::frame f(w);
+        long long* p = w.allocate<long long>(10);
+        p[9] = 7;
+        long long* q = w.allocate<long long>(100000);
+        CPPUNIT_ASSERT(p[9] == 7);
+        CPPUNIT_ASSERT(q[99999] == 0);
+        CPPUNIT_ASSERT(w.capacity() >= 100010 * sizeof(long long));
+    }
+
+    // Repeating a division draws everything from the same workspace
+    void test_workspace_03 () {
+        std::vector<unsigned> a(250);
+        std::vector<unsigned> b(90);
+        for (std::size_t i = 0; i < a.size(); ++i)
+            a[i] = 2654435761u * (i + 1);
+        for (std::size_t i = 0; i < b.size(); ++i)
+            b[i] = 4294967295u - 40503u * i;
+        std::vector<unsigned> q1(250);
+        std::vector<unsigned> q2(250);
+        workspace w;
+        std::vector<unsigned>::iterator p = divides_digits(a.begin(), a.end(), b.begin(), b.end(), q1.begin(), binary32_radix(), w);
+        const std::size_t capacity = w.capacity();
+        std::vector<unsigned>::iterator q = divides_digits(a.begin(), a.end(), b.begin(), b.end(), q2.begin(), binary32_radix(), w);
+        CPPUNIT_ASSERT(w.capacity() == capacity);
+        CPPUNIT_ASSERT(p - q1.begin() == 160);
+        CPPUNIT_ASSERT(q - q2.begin() == 160);
+        CPPUNIT_ASSERT(std::equal(q1.begin(), p, q2.begin()));
+    }
+
+    // ------------
+    // small_vector
+    // ------------
+
+    void test_small_vector_01 () {
+        small_vector<int, 4> x(3, 7);
+        CPPUNIT_ASSERT(x.size() == 3);
+        CPPUNIT_ASSERT(x.capacity() == 4);
+        x.push_back(1);
+        x.push_back(2);
+        CPPUNIT_ASSERT(x.size() == 5);
+        CPPUNIT_ASSERT(x.capacity() >= 5);
+        const int a[] = {7, 7, 7, 1, 2};
+        CPPUNIT_ASSERT(std::equal(x.begin(), x.end(), a));
+    }
+
+    void test_small_vector_02 () {
+        small_vector<int, 4> x(2, 5);
+        x.insert(x.begin(), 3, 0);
+        x.erase(x.begin() + 1, x.begin() + 3);
+        const int a[] = {0, 5, 5};
+        CPPUNIT_ASSERT(x.size() == 3);
+        CPPUNIT_ASSERT(std::equal(x.begin(), x.end(), a));
+    }
+
+    // One inline and one on the heap
+    void test_small_vector_03 () {
+        small_vector<int, 2> x(1, 1);
+        small_vector<int, 2> y(6, 2);
+        x.swap(y);
+        CPPUNIT_ASSERT(x.size() == 6);
+        CPPUNIT_ASSERT(y.size() == 1);
+        CPPUNIT_ASSERT(x[5] == 2);
+        CPPUNIT_ASSERT(y[0] == 1);
+    }
+
+    // Vectors of Integers move them when they grow, rather than copy
+    void test_small_vector_04 () {
+        CPPUNIT_ASSERT((std::is_nothrow_move_constructible< small_vector<int, 4> >::value));
+        CPPUNIT_ASSERT((std::is_nothrow_move_assignable< small_vector<int, 4> >::value));
+        CPPUNIT_ASSERT(std::is_nothrow_move_constructible< Integer<int> >::value);
+    }
+
     // -----------
     // constructor
     // -----------
@@ -591,6 +1202,41 @@ struct TestInteger : CppUnit::TestFixture {
         }
     }
 
+    void test_constructor_4 () {
+        try {
+            const Integer<int> x("-12a4b");
+            CPPUNIT_ASSERT(false);
+        }
+        catch (parse_error& e) {
+            CPPUNIT_ASSERT(e.position() == 3);
+        }
+    }
+
+    void test_constructor_5 () {
+        const char s[] = "x-00120y";
+        const Integer<int> x(s + 1, s + 7);
+        CPPUNIT_ASSERT(x == -120);
+    }
+
+    void test_constructor_6 () {
+        typedef Integer<unsigned, std::vector<unsigned>, binary32_radix> binary_integer;
+        try {
+            const binary_integer x("123456789x123456789y");
+            CPPUNIT_ASSERT(false);
+        }
+        catch (parse_error& e) {
+            CPPUNIT_ASSERT(e.position() == 9);
+        }
+    }
+
+    // Long enough to join the chunks by halves
+    void test_constructor_7 () {
+        typedef Integer<unsigned, std::vector<unsigned>, binary32_radix> binary_integer;
+        const std::string s = to_string(Integer<int>(7).pow(1500));
+        const binary_integer x(s);
+        CPPUNIT_ASSERT(x == binary_integer(7).pow(1500));
+    }
+
     // ---
     // abs
     // ---
@@ -815,6 +1461,33 @@ struct TestInteger : CppUnit::TestFixture {
         }
     }
 
+    void test_to_string () {
+        const Integer<int> x ("-12345678987654321");
+        CPPUNIT_ASSERT(to_string(x) == "-12345678987654321");
+    }
+
+    void test_to_chars () {
+        const Integer<int> x = -98765;
+        char buffer[8];
+        char* p = to_chars(buffer, buffer + 8, x);
+        CPPUNIT_ASSERT(p == buffer + 6);
+        CPPUNIT_ASSERT(std::equal(buffer, p, "-98765"));
+        CPPUNIT_ASSERT(to_chars(buffer, buffer + 5, x) == 0);
+    }
+
+    // Limbs render straight into the buffer, which may be exactly as long
+    // as the number
+    void test_to_chars_binary () {
+        typedef Integer<unsigned, std::vector<unsigned>, binary32_radix> binary_integer;
+        const binary_integer x = -binary_integer(7).pow(60);
+        const std::string s = to_string(x);
+        CPPUNIT_ASSERT(s == "-508021860739623365322188197652216501772434524836001");
+        std::vector<char> buffer(s.size());
+        CPPUNIT_ASSERT(to_chars(&buffer[0], &buffer[0] + buffer.size(), x) == &buffer[0] + buffer.size());
+        CPPUNIT_ASSERT(std::equal(buffer.begin(), buffer.end(), s.begin()));
+        CPPUNIT_ASSERT(to_chars(&buffer[0], &buffer[0] + buffer.size() - 1, x) == 0);
+    }
+
 
     // ---
     // pow
@@ -909,6 +1582,313 @@ struct TestInteger : CppUnit::TestFixture {
         }
     }
 
+    void test_square_01 () {
+        Integer<int> x = -111111111;
+        const Integer<int> y = square(x);
+        x *= x;
+        CPPUNIT_ASSERT(x == Integer<int>("12345678987654321"));
+        CPPUNIT_ASSERT(y == x);
+        CPPUNIT_ASSERT(x.square() == Integer<int>("152415789666209420210333789971041"));
+    }
+
+    void test_square_02 () {
+        typedef Integer<unsigned, std::vector<unsigned>, binary32_radix> binary_integer;
+        binary_integer x = binary_integer(3).pow(2000);
+        const binary_integer y = x;
+        x.square();
+        CPPUNIT_ASSERT(x == y * binary_integer(y));
+        CPPUNIT_ASSERT(x == binary_integer(3).pow(4000));
+    }
+
+    void test_powmod_01 () {
+        const Integer<int> x = 12345;
+        const Integer<int> e("98765432109876543210");
+        CPPUNIT_ASSERT(powmod(x, e, Integer<int>("1000000000000000000000000000057")) == Integer<int>("917159860087255474787801943761"));
+        CPPUNIT_ASSERT(powmod(x, e, Integer<int>(2).pow(100)) == Integer<int>("685884628300473500535611149937"));
+        CPPUNIT_ASSERT(powmod(Integer<int>(-2), 3, 5) == 2);
+        CPPUNIT_ASSERT(powmod(Integer<int>(-2), 4, 5) == 1);
+        CPPUNIT_ASSERT(powmod(x, 0, 7) == 1);
+        CPPUNIT_ASSERT(powmod(x, 5, 1) == 0);
+    }
+
+    void test_powmod_02 () {
+        typedef Integer<unsigned, std::vector<unsigned>, binary32_radix> binary_integer;
+        const binary_integer m = binary_integer(2).pow(127) - 1;
+        binary_integer x = 98765;
+        x.powmod(binary_integer(2).pow(200) + 1, m);
+        CPPUNIT_ASSERT(x == binary_integer("52879670760173864519402865084401166699"));
+        // Fermat, 2^521 - 1 is prime
+        const binary_integer p = binary_integer(2).pow(521) - 1;
+        CPPUNIT_ASSERT(powmod(binary_integer(3), p - 1, p) == 1);
+    }
+
+    void test_powmod_03 () {
+        try {
+            powmod(Integer<int>(2), -1, 5);
+            CPPUNIT_ASSERT(false);
+        }
+        catch (std::invalid_argument& e) {
+            CPPUNIT_ASSERT(strcmp(e.what(), "Integer::powmod()") == 0);
+        }
+        try {
+            powmod(Integer<int>(2), 1, 0);
+            CPPUNIT_ASSERT(false);
+        }
+        catch (std::invalid_argument& e) {
+        }
+    }
+
+    void test_reducer_01 () {
+        const Integer<int> m("1000000000000000000000000000057");
+        const Integer<int>::reducer r(m);
+        Integer<int> x = Integer<int>(12345).pow(20);
+        Integer<int> y = -Integer<int>(12345).pow(20);
+        Integer<int> z = 42;
+        CPPUNIT_ASSERT(&r.reduce(x) == &x);
+        r.reduce(y);
+        r.reduce(z);
+        CPPUNIT_ASSERT(x == Integer<int>(12345).pow(20) % m);
+        CPPUNIT_ASSERT(y == -x);
+        CPPUNIT_ASSERT(z == 42);
+        Integer<int> w = m * 3;
+        CPPUNIT_ASSERT(r.reduce(w) == 0);
+    }
+
+    void test_reducer_02 () {
+        typedef Integer<unsigned, std::vector<unsigned>, binary32_radix> binary_integer;
+        const binary_integer m = binary_integer(2).pow(200) + 1;
+        const binary_integer::reducer r(m);
+        std::vector<binary_integer> x;
+        for (int i = 1; i < 40; ++i)
+            x.push_back(binary_integer(7).pow(i * 5));
+        std::vector<binary_integer> y(x);
+        r.reduce(x.begin(), x.end());
+        for (std::size_t i = 0; i < x.size(); ++i)
+            CPPUNIT_ASSERT(x[i] == y[i] % m);
+    }
+
+    void test_reducer_03 () {
+        try {
+            const Integer<int>::reducer r(0);
+            CPPUNIT_ASSERT(false);
+        }
+        catch (std::invalid_argument& e) {
+            CPPUNIT_ASSERT(strcmp(e.what(), "Integer::reducer()") == 0);
+        }
+    }
+
+    void test_gcd_01 () {
+        const Integer<int> p = Integer<int>(2).pow(127) - 1;
+        const Integer<int> q = Integer<int>(5).pow(90);
+        CPPUNIT_ASSERT(gcd(p * q * 12, -p * 18) == p * 6);
+        CPPUNIT_ASSERT(gcd(p, q) == 1);
+        CPPUNIT_ASSERT(gcd(Integer<int>(0), -q) == q);
+        CPPUNIT_ASSERT(gcd(Integer<int>(0), 0) == 0);
+    }
+
+    void test_gcd_02 () {
+        typedef Integer<unsigned, std::vector<unsigned>, binary32_radix> binary_integer;
+        const binary_integer a = binary_integer(2).pow(300) * binary_integer(5).pow(80);
+        const binary_integer b = binary_integer(2).pow(250) * binary_integer(5).pow(120) * 7;
+        CPPUNIT_ASSERT(gcd(a, b) == binary_integer(2).pow(250) * binary_integer(5).pow(80));
+    }
+
+    void test_extended_gcd () {
+        const Integer<int> a = -Integer<int>(7).pow(60) * 10;
+        const Integer<int> b = Integer<int>(11).pow(50) * 4;
+        Integer<int> x = 0;
+        Integer<int> y = 0;
+        CPPUNIT_ASSERT(extended_gcd(a, b, x, y) == 2);
+        CPPUNIT_ASSERT(a * x + b * y == 2);
+        CPPUNIT_ASSERT(extended_gcd(a, Integer<int>(0), x, y) == -a);
+        CPPUNIT_ASSERT(x == -1 && y == 0);
+    }
+
+    void test_mod_inverse () {
+        const Integer<int> m = Integer<int>(2).pow(89) - 1;
+        const Integer<int> x = mod_inverse(Integer<int>(-3), m);
+        CPPUNIT_ASSERT(x > 0 && x < m);
+        CPPUNIT_ASSERT((x * 3 + 1) % m == 0);
+        try {
+            mod_inverse(Integer<int>(6), 15);
+            CPPUNIT_ASSERT(false);
+        }
+        catch (std::invalid_argument& e) {
+            CPPUNIT_ASSERT(strcmp(e.what(), "Integer::mod_inverse()") == 0);
+        }
+    }
+
+    void test_divexact_01 () {
+        const Integer<int> b = Integer<int>(10).pow(25) * 48;
+        Integer<int> x = -Integer<int>(7).pow(90) * b;
+        CPPUNIT_ASSERT(&x.divexact(b) == &x);
+        CPPUNIT_ASSERT(x == -Integer<int>(7).pow(90));
+        CPPUNIT_ASSERT(divexact(x, -x) == -1);
+        CPPUNIT_ASSERT(divexact(Integer<int>(0), b) == 0);
+    }
+
+    void test_divexact_02 () {
+        typedef Integer<unsigned, std::vector<unsigned>, binary32_radix> binary_integer;
+        const binary_integer b = binary_integer(2).pow(100) * binary_integer(3).pow(200);
+        const binary_integer q = binary_integer(11).pow(300) + 1;
+        CPPUNIT_ASSERT(divexact(q * b, b) == q);
+        CPPUNIT_ASSERT(divexact(q * b, q) == b);
+    }
+
+    void test_divexact_03 () {
+        try {
+            divexact(Integer<int>(12345), Integer<int>(0));
+            CPPUNIT_ASSERT(false);
+        }
+        catch (std::invalid_argument& e) {
+            CPPUNIT_ASSERT(strcmp(e.what(), "Integer::divexact()") == 0);
+        }
+    }
+
+    void test_divmod_01 () {
+        Integer<int> x = -Integer<int>(10).pow(40) - 7;
+        Integer<int> r = 99;
+        CPPUNIT_ASSERT(&x.divmod(Integer<int>(10).pow(20) + 3, r) == &x);
+        CPPUNIT_ASSERT(x == -Integer<int>("99999999999999999997"));
+        CPPUNIT_ASSERT(r == -16);
+        Integer<int> y = 12;
+        y.divmod(-Integer<int>(10).pow(30), r);
+        CPPUNIT_ASSERT(y == 0 && r == 12);
+    }
+
+    void test_divmod_02 () {
+        typedef Integer<unsigned, std::vector<unsigned>, binary32_radix> binary_integer;
+        const binary_integer x = binary_integer(3).pow(200);
+        const binary_integer y = binary_integer(7).pow(50);
+        const std::pair<binary_integer, binary_integer> qr = divmod(x, y);
+        CPPUNIT_ASSERT(qr.first == x / y);
+        CPPUNIT_ASSERT(qr.second == x % y);
+        CPPUNIT_ASSERT(qr.first * y + qr.second == x);
+        binary_integer z = y;
+        binary_integer r = y;
+        z.divmod(r, r);
+        CPPUNIT_ASSERT(z == 1 && r == 0);
+    }
+
+    // /= and %= divide through divmod, so all three throw on 0
+    void test_divmod_03 () {
+        Integer<int> x = 12345;
+        const Integer<int> zero = 0;
+        try {
+            divmod(x, zero);
+            CPPUNIT_ASSERT(false);
+        }
+        catch (std::invalid_argument& e) {
+            CPPUNIT_ASSERT(strcmp(e.what(), "Integer::divmod()") == 0);
+        }
+        try {
+            x /= zero;
+            CPPUNIT_ASSERT(false);
+        }
+        catch (std::invalid_argument& e) {
+            CPPUNIT_ASSERT(strcmp(e.what(), "Integer::divmod()") == 0);
+        }
+        try {
+            x %= zero;
+            CPPUNIT_ASSERT(false);
+        }
+        catch (std::invalid_argument& e) {
+            CPPUNIT_ASSERT(strcmp(e.what(), "Integer::divmod()") == 0);
+        }
+        CPPUNIT_ASSERT(x == 12345);
+    }
+
+    void test_scalar_01 () {
+        Integer<int> x("123456789012345678901234567890");
+        x += 10LL;
+        x -= 1000000000000000000ULL;
+        CPPUNIT_ASSERT(x == Integer<int>("123456789011345678901234567900"));
+        x *= -9000000000000000000LL;
+        CPPUNIT_ASSERT(x == -Integer<int>("1111111101102111110111111111100000000000000000000"));
+        CPPUNIT_ASSERT(x % 7 == -4);
+        x /= -3;
+        CPPUNIT_ASSERT(x == Integer<int>("370370367034037036703703703700000000000000000000"));
+        x %= 1000003;
+        CPPUNIT_ASSERT(x == 570433);
+    }
+
+    void test_scalar_02 () {
+        typedef Integer<unsigned, std::vector<unsigned>, binary32_radix> binary_integer;
+        const binary_integer x = binary_integer(2).pow(64) - 1;
+        CPPUNIT_ASSERT(x == 18446744073709551615ULL);
+        CPPUNIT_ASSERT(18446744073709551614ULL < x);
+        CPPUNIT_ASSERT(x > -9223372036854775807LL - 1);
+        CPPUNIT_ASSERT(-x < 0 && -x <= -1 && 0 != -x);
+        binary_integer y = x;
+        y *= 10000000000ULL;
+        y /= 10000000000ULL;
+        CPPUNIT_ASSERT(y == x);
+        CPPUNIT_ASSERT(++y == binary_integer(2).pow(64));
+    }
+
+    // Built-in zero divisors throw like Integer ones
+    void test_scalar_03 () {
+        Integer<int> x = 12345;
+        try {
+            x /= 0;
+            CPPUNIT_ASSERT(false);
+        }
+        catch (std::invalid_argument& e) {
+            CPPUNIT_ASSERT(strcmp(e.what(), "Integer::operator/=()") == 0);
+        }
+        try {
+            x % 0ULL;
+            CPPUNIT_ASSERT(false);
+        }
+        catch (std::invalid_argument& e) {
+            CPPUNIT_ASSERT(strcmp(e.what(), "Integer::operator%=()") == 0);
+        }
+        CPPUNIT_ASSERT(x == 12345);
+    }
+
+    // -------------
+    // binary limbs
+    // -------------
+
+    void test_binary_output () {
+        typedef Integer<unsigned, std::vector<unsigned>, binary32_radix> binary_integer;
+        const binary_integer x = binary_integer(2).pow(64);
+        std::ostringstream out;
+        out << x;
+        CPPUNIT_ASSERT(out.str() == "18446744073709551616");
+    }
+
+    // Long enough to split by powers of 10^9
+    void test_binary_output_01 () {
+        typedef Integer<unsigned, std::vector<unsigned>, binary32_radix> binary_integer;
+        const Integer<int> x = Integer<int>(3).pow(2000);
+        const binary_integer y = binary_integer(3).pow(2000);
+        CPPUNIT_ASSERT(to_string(x) == to_string(y));
+    }
+
+    void test_binary_string () {
+        typedef Integer<unsigned, std::deque<unsigned>, binary32_radix> binary_integer;
+        const binary_integer x ("-12345678987654321");
+        std::ostringstream out;
+        out << x;
+        CPPUNIT_ASSERT(out.str() == "-12345678987654321");
+    }
+
+    void test_binary_arithmetic () {
+        typedef Integer<unsigned, std::vector<unsigned>, binary32_radix> binary_integer;
+        binary_integer x ("12345678987654321");
+        x /= binary_integer("111111111");
+        CPPUNIT_ASSERT(x == 111111111);
+        x *= x;
+        x -= 1;
+        x %= 1000;
+        CPPUNIT_ASSERT(x == 320);
+        x.shift_left_decimal(2);
+        CPPUNIT_ASSERT(x == 32000);
+        x.shift_right_decimal(3);
+        CPPUNIT_ASSERT(x == 32);
+    }
+
     // ---------
     // operators
     // ---------
@@ -973,6 +1953,16 @@ struct TestInteger : CppUnit::TestFixture {
         CPPUNIT_ASSERT(x == 3);
     }
 
+    void test_minus_equal_06 () {
+        Integer<int> x = 25;
+        const Integer<int> y = 30;
+        x -= y;
+        CPPUNIT_ASSERT(x == -5);
+        CPPUNIT_ASSERT(y == 30);
+        x -= x;
+        CPPUNIT_ASSERT(x == 0);
+    }
+
     void test_multiply_equal_01 () {
         Integer<int> x = 2;
         x *= 4;
@@ -1039,6 +2029,12 @@ struct TestInteger : CppUnit::TestFixture {
         CPPUNIT_ASSERT(x == 2);
     }
 
+    void test_divide_equal_07 () {
+        Integer<int> x = Integer<int>(7).pow(200) + 5;
+        x /= Integer<int>(7).pow(120);
+        CPPUNIT_ASSERT(x == Integer<int>(7).pow(80));
+    }
+
     void test_mod_equal_01 () {
         Integer<int> x = 10;
         x %= 5;
@@ -1057,42 +2053,178 @@ struct TestInteger : CppUnit::TestFixture {
         CPPUNIT_ASSERT(x == 2);
     }
 
-    void test_shift_left_equal_01 () {
+    void test_shift_left_decimal_01 () {
         Integer<int> x = 10;
-        x <<= 1;
+        x.shift_left_decimal(1);
         CPPUNIT_ASSERT(x == 100);
     }
 
-    void test_shift_left_equal_02 () {
+    void test_shift_left_decimal_02 () {
         Integer<int> x = 12345;
-        x <<= 2;
+        x.shift_left_decimal(2);
         CPPUNIT_ASSERT(x == 1234500);
     }
 
-    void test_shift_left_equal_03 () {
+    void test_shift_left_decimal_03 () {
         Integer<int> x = 0;
-        x <<= 2;
+        x.shift_left_decimal(2);
         CPPUNIT_ASSERT(x == 0);
     }
 
-    void test_shift_right_equal_01 () {
+    void test_shift_right_decimal_01 () {
         Integer<int> x = 10;
-        x >>= 1;
+        x.shift_right_decimal(1);
         CPPUNIT_ASSERT(x == 1);
     }
 
-    void test_shift_right_equal_02 () {
+    void test_shift_right_decimal_02 () {
         Integer<int> x = 10;
-        x >>= 2;
+        x.shift_right_decimal(2);
         CPPUNIT_ASSERT(x == 0);
     }
     
-    void test_shift_right_equal_03 () {
+    void test_shift_right_decimal_03 () {
         Integer<int> x = 12345;
-        x >>= 2;
+        x.shift_right_decimal(2);
         CPPUNIT_ASSERT(x == 123);
     }
     
+    void test_shift_left_equal_01 () {
+        Integer<int> x = -12345;
+        x <<= 40;
+        CPPUNIT_ASSERT(x == -Integer<int>("13573471044894720"));
+        CPPUNIT_ASSERT((x << 0) == x);
+        try {
+            x <<= -1;
+            CPPUNIT_ASSERT(false);
+        }
+        catch (std::invalid_argument& e) {
+            CPPUNIT_ASSERT(strcmp(e.what(), "Integer::operator<<=()") == 0);
+        }
+    }
+
+    void test_shift_left_equal_02 () {
+        typedef Integer<unsigned, std::vector<unsigned>, binary32_radix> binary_integer;
+        binary_integer x = binary_integer(3).pow(100);
+        x <<= 133;
+        CPPUNIT_ASSERT(x == binary_integer(3).pow(100) * binary_integer(2).pow(133));
+    }
+
+    void test_shift_right_equal_01 () {
+        Integer<int> x = -1000;
+        x >>= 3;
+        CPPUNIT_ASSERT(x == -125);
+        x >>= 3;
+        CPPUNIT_ASSERT(x == -16);
+        x >>= 20;
+        CPPUNIT_ASSERT(x == -1);
+        CPPUNIT_ASSERT((Integer<int>(1000) >> 3) == 125);
+    }
+
+    void test_shift_right_equal_02 () {
+        typedef Integer<unsigned, std::vector<unsigned>, binary32_radix> binary_integer;
+        binary_integer x = binary_integer(2).pow(200) + 5;
+        CPPUNIT_ASSERT((x >> 197) == 8);
+        CPPUNIT_ASSERT((-x >> 197) == -9);
+        CPPUNIT_ASSERT((-x >> 300) == -1 && (x >> 300) == 0);
+        CPPUNIT_ASSERT((binary_integer(-5) >> 31) == -1);
+    }
+
+    void test_shift_equal_03 () {
+        const Integer<int> x = Integer<int>(3).pow(50);
+        const Integer<int> y = x * Integer<int>(2).pow(100);
+        CPPUNIT_ASSERT((x << 100) == y);
+        CPPUNIT_ASSERT(((y + 1) >> 100) == x);
+        CPPUNIT_ASSERT((-(y + 1) >> 100) == -x - 1);
+        CPPUNIT_ASSERT((-y >> 100) == -x);
+        CPPUNIT_ASSERT((Integer<int>(-5) >> 1000) == -1 && (Integer<int>(5) >> 1000) == 0);
+    }
+
+    void test_bitwise_01 () {
+        const Integer<int> x("123456789123456789123456789");
+        const Integer<int> y("987654321987654321");
+        CPPUNIT_ASSERT((x & y) == Integer<int>("45194461172732433"));
+        CPPUNIT_ASSERT((x | y) == Integer<int>("123456790065916649938378677"));
+        CPPUNIT_ASSERT((x ^ y) == Integer<int>("123456790020722188765646244"));
+        CPPUNIT_ASSERT(~x == -x - 1);
+    }
+
+    void test_bitwise_02 () {
+        typedef Integer<unsigned, std::vector<unsigned>, binary32_radix> binary_integer;
+        const binary_integer x = -binary_integer(2).pow(64);
+        const binary_integer y = binary_integer(2).pow(70) - 1;
+        CPPUNIT_ASSERT((x & y) == binary_integer(2).pow(70) - binary_integer(2).pow(64));
+        CPPUNIT_ASSERT((x | y) == -1);
+        CPPUNIT_ASSERT((x ^ -1) == binary_integer(2).pow(64) - 1);
+        CPPUNIT_ASSERT((Integer<int>(-6) & -11) == -16);
+        CPPUNIT_ASSERT((Integer<int>(-6) | 9) == -5);
+    }
+
+    void test_bit_queries () {
+        const Integer<int> x = Integer<int>(2).pow(100) + 40;
+        CPPUNIT_ASSERT(x.bit_length() == 101);
+        CPPUNIT_ASSERT(x.popcount() == 3);
+        CPPUNIT_ASSERT(x.lowest_set_bit() == 3);
+        CPPUNIT_ASSERT(x.test_bit(5) && !x.test_bit(4) && x.test_bit(100) && !x.test_bit(101));
+        const Integer<int> y = -x;
+        CPPUNIT_ASSERT(!y.test_bit(2) && y.test_bit(3) && !y.test_bit(5) && y.test_bit(4) && !y.test_bit(100) && y.test_bit(1000));
+        CPPUNIT_ASSERT(Integer<int>(0).bit_length() == 0);
+        try {
+            Integer<int>(0).lowest_set_bit();
+            CPPUNIT_ASSERT(false);
+        }
+        catch (std::invalid_argument& e) {
+            CPPUNIT_ASSERT(strcmp(e.what(), "Integer::lowest_set_bit()") == 0);
+        }
+    }
+
+    // Expiring operands lend their storage to the result
+    void test_rvalue_operators () {
+        const Integer<int> x = 999;
+        CPPUNIT_ASSERT(Integer<int>(1) + x == 1000);
+        CPPUNIT_ASSERT(x - Integer<int>(1000) == -1);
+        CPPUNIT_ASSERT(Integer<int>(3) * Integer<int>(-4) == -12);
+        CPPUNIT_ASSERT(-Integer<int>(7) == -7);
+        Integer<int> y = 1;
+        y -= Integer<int>(12345);
+        CPPUNIT_ASSERT(y == -12344);
+        y += Integer<int>(-5);
+        CPPUNIT_ASSERT(y == -12349);
+    }
+
+    // -----------
+    // expressions
+    // -----------
+
+    void test_expression_01 () {
+        const Integer<int> a = 12;
+        const Integer<int> b = -7;
+        const Integer<int> c = 5;
+        const Integer<int> x = a * b + c * c - 3;
+        CPPUNIT_ASSERT(x == -62);
+    }
+
+    // The destination appears in its own expression
+    void test_expression_02 () {
+        Integer<int> x = 6;
+        const Integer<int> y = 4;
+        x = y * x - x;
+        CPPUNIT_ASSERT(x == 18);
+        x += x * y;
+        CPPUNIT_ASSERT(x == 90);
+        x -= (x + y) * 2;
+        CPPUNIT_ASSERT(x == -98);
+    }
+
+    void test_expression_03 () {
+        typedef Integer<unsigned, std::vector<unsigned>, binary32_radix> binary_integer;
+        const binary_integer a("123456789012345678901234567890");
+        const binary_integer b("987654321098765432109876543210");
+        const binary_integer x = (a + b) * (a - b);
+        CPPUNIT_ASSERT(x == a * a - b * b);
+        CPPUNIT_ASSERT(-(a * b) == b * -a);
+    }
+
     // -----
     // suite
     // -----
@@ -1113,6 +2245,7 @@ struct TestInteger : CppUnit::TestFixture {
     CPPUNIT_TEST(test_compare_03);
     CPPUNIT_TEST(test_compare_04);
     CPPUNIT_TEST(test_compare_05);
+    CPPUNIT_TEST(test_compare_06);
 
     CPPUNIT_TEST(test_shift_left_digits);
     CPPUNIT_TEST(test_shift_left_digits_01);
@@ -1128,17 +2261,44 @@ struct TestInteger : CppUnit::TestFixture {
     CPPUNIT_TEST(test_plus_digits_03);
     CPPUNIT_TEST(test_plus_digits_04);
     CPPUNIT_TEST(test_plus_digits_05);
+    CPPUNIT_TEST(test_plus_digits_06);
+    CPPUNIT_TEST(test_plus_digits_07);
+    CPPUNIT_TEST(test_plus_digits_08);
+    CPPUNIT_TEST(test_plus_digits_09);
     CPPUNIT_TEST(test_minus_digits);
     CPPUNIT_TEST(test_minus_digits_01);
     CPPUNIT_TEST(test_minus_digits_02);
     CPPUNIT_TEST(test_minus_digits_03);
     CPPUNIT_TEST(test_minus_digits_04);
+    CPPUNIT_TEST(test_minus_digits_05);
+    CPPUNIT_TEST(test_minus_digits_06);
+    CPPUNIT_TEST(test_minus_digits_07);
     CPPUNIT_TEST(test_multiplies_digits);
     CPPUNIT_TEST(test_multiplies_digits_01);
     CPPUNIT_TEST(test_multiplies_digits_02);
     CPPUNIT_TEST(test_multiplies_digits_03);
     CPPUNIT_TEST(test_multiplies_digits_04);
     CPPUNIT_TEST(test_multiplies_digits_05);
+    CPPUNIT_TEST(test_multiplies_digits_06);
+    CPPUNIT_TEST(test_multiplies_digits_07);
+    CPPUNIT_TEST(test_multiplies_digits_08);
+    CPPUNIT_TEST(test_multiplies_digits_09);
+    CPPUNIT_TEST(test_multiplies_digits_10);
+    CPPUNIT_TEST(test_multiplies_digits_11);
+    CPPUNIT_TEST(test_multiplies_digits_12);
+    CPPUNIT_TEST(test_multiplies_digits_13);
+    CPPUNIT_TEST(test_thread_pool);
+    CPPUNIT_TEST(test_square_digits_01);
+    CPPUNIT_TEST(test_square_digits_02);
+    CPPUNIT_TEST(test_lucas_lehmer_01);
+    CPPUNIT_TEST(test_lucas_lehmer_02);
+    CPPUNIT_TEST(test_mersenne_reduce_limbs);
+    CPPUNIT_TEST(test_powmod_digits_01);
+    CPPUNIT_TEST(test_powmod_digits_02);
+    CPPUNIT_TEST(test_gcd_digits);
+    CPPUNIT_TEST(test_divides_exact_digits);
+    CPPUNIT_TEST(test_multiplies_digit);
+    CPPUNIT_TEST(test_divides_digit);
     CPPUNIT_TEST(test_divides_digits);
     CPPUNIT_TEST(test_divides_digits_01);
     CPPUNIT_TEST(test_divides_digits_02);
@@ -1154,9 +2314,28 @@ struct TestInteger : CppUnit::TestFixture {
     CPPUNIT_TEST(test_divides_digits_12);
     CPPUNIT_TEST(test_divides_digits_13);
     CPPUNIT_TEST(test_divides_digits_14);
+    CPPUNIT_TEST(test_divides_digits_15);
+    CPPUNIT_TEST(test_divides_digits_16);
+    CPPUNIT_TEST(test_divides_digits_17);
+    CPPUNIT_TEST(test_divides_digits_18);
+    CPPUNIT_TEST(test_divides_digits_19);
+    CPPUNIT_TEST(test_radix_to_decimal);
+    CPPUNIT_TEST(test_radix_to_decimal_01);
+    CPPUNIT_TEST(test_decimal_to_radix);
+    CPPUNIT_TEST(test_workspace_01);
+    CPPUNIT_TEST(test_workspace_02);
+    CPPUNIT_TEST(test_workspace_03);
+    CPPUNIT_TEST(test_small_vector_01);
+    CPPUNIT_TEST(test_small_vector_02);
+    CPPUNIT_TEST(test_small_vector_03);
+    CPPUNIT_TEST(test_small_vector_04);
     CPPUNIT_TEST(test_constructor_1);
     CPPUNIT_TEST(test_constructor_2);
     CPPUNIT_TEST(test_constructor_3);
+    CPPUNIT_TEST(test_constructor_4);
+    CPPUNIT_TEST(test_constructor_5);
+    CPPUNIT_TEST(test_constructor_6);
+    CPPUNIT_TEST(test_constructor_7);
     CPPUNIT_TEST(test_abs_1);
     CPPUNIT_TEST(test_abs_2);
     CPPUNIT_TEST(test_lt_01);
@@ -1169,6 +2348,9 @@ struct TestInteger : CppUnit::TestFixture {
     CPPUNIT_TEST(test_output);
     CPPUNIT_TEST(test_output_1);
     CPPUNIT_TEST(test_output_2);
+    CPPUNIT_TEST(test_to_string);
+    CPPUNIT_TEST(test_to_chars);
+    CPPUNIT_TEST(test_to_chars_binary);
 
     // They take a while, but pass
    // CPPUNIT_TEST(test_pow_1);
@@ -1178,6 +2360,31 @@ struct TestInteger : CppUnit::TestFixture {
     CPPUNIT_TEST(test_pow_4);
     CPPUNIT_TEST(test_pow_5);
     CPPUNIT_TEST(test_pow_6);
+    CPPUNIT_TEST(test_square_01);
+    CPPUNIT_TEST(test_square_02);
+    CPPUNIT_TEST(test_powmod_01);
+    CPPUNIT_TEST(test_powmod_02);
+    CPPUNIT_TEST(test_powmod_03);
+    CPPUNIT_TEST(test_reducer_01);
+    CPPUNIT_TEST(test_reducer_02);
+    CPPUNIT_TEST(test_reducer_03);
+    CPPUNIT_TEST(test_gcd_01);
+    CPPUNIT_TEST(test_gcd_02);
+    CPPUNIT_TEST(test_extended_gcd);
+    CPPUNIT_TEST(test_mod_inverse);
+    CPPUNIT_TEST(test_divexact_01);
+    CPPUNIT_TEST(test_divexact_02);
+    CPPUNIT_TEST(test_divexact_03);
+    CPPUNIT_TEST(test_divmod_01);
+    CPPUNIT_TEST(test_divmod_02);
+    CPPUNIT_TEST(test_divmod_03);
+    CPPUNIT_TEST(test_scalar_01);
+    CPPUNIT_TEST(test_scalar_02);
+    CPPUNIT_TEST(test_scalar_03);
+    CPPUNIT_TEST(test_binary_output);
+    CPPUNIT_TEST(test_binary_output_01);
+    CPPUNIT_TEST(test_binary_string);
+    CPPUNIT_TEST(test_binary_arithmetic);
     CPPUNIT_TEST(test_plus_equal_01);
     CPPUNIT_TEST(test_plus_equal_02);
     CPPUNIT_TEST(test_plus_equal_03);
@@ -1188,6 +2395,7 @@ struct TestInteger : CppUnit::TestFixture {
     CPPUNIT_TEST(test_minus_equal_03);
     CPPUNIT_TEST(test_minus_equal_04);
     CPPUNIT_TEST(test_minus_equal_05);
+    CPPUNIT_TEST(test_minus_equal_06);
     CPPUNIT_TEST(test_multiply_equal_01);
     CPPUNIT_TEST(test_multiply_equal_02);
     CPPUNIT_TEST(test_multiply_equal_03);
@@ -1198,15 +2406,29 @@ struct TestInteger : CppUnit::TestFixture {
     CPPUNIT_TEST(test_divide_equal_03);
     CPPUNIT_TEST(test_divide_equal_04);
     CPPUNIT_TEST(test_divide_equal_05);
+    CPPUNIT_TEST(test_divide_equal_06);
+    CPPUNIT_TEST(test_divide_equal_07);
     CPPUNIT_TEST(test_mod_equal_01);
     CPPUNIT_TEST(test_mod_equal_02);
     CPPUNIT_TEST(test_mod_equal_03);
+    CPPUNIT_TEST(test_rvalue_operators);
+    CPPUNIT_TEST(test_expression_01);
+    CPPUNIT_TEST(test_expression_02);
+    CPPUNIT_TEST(test_expression_03);
+    CPPUNIT_TEST(test_shift_left_decimal_01);
+    CPPUNIT_TEST(test_shift_left_decimal_02);
+    CPPUNIT_TEST(test_shift_left_decimal_03);
+    CPPUNIT_TEST(test_shift_right_decimal_01);
+    CPPUNIT_TEST(test_shift_right_decimal_02);
+    CPPUNIT_TEST(test_shift_right_decimal_03);
     CPPUNIT_TEST(test_shift_left_equal_01);
     CPPUNIT_TEST(test_shift_left_equal_02);
-    CPPUNIT_TEST(test_shift_left_equal_03);
     CPPUNIT_TEST(test_shift_right_equal_01);
     CPPUNIT_TEST(test_shift_right_equal_02);
-    CPPUNIT_TEST(test_shift_right_equal_03);
+    CPPUNIT_TEST(test_shift_equal_03);
+    CPPUNIT_TEST(test_bitwise_01);
+    CPPUNIT_TEST(test_bitwise_02);
+    CPPUNIT_TEST(test_bit_queries);
     CPPUNIT_TEST_SUITE_END();
 };
 